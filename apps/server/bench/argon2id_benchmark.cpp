@@ -0,0 +1,104 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <prapancha/security/hasher.h>
+
+/// Hashes with Argon2id at several threads per hash, alone for latency and from many callers at once for throughput,
+/// and calibrates against a latency target at each setting.
+///
+/// Usage: argon2id_benchmark [hashes] [callers] [target_ms]
+namespace mehara::prapancha::bench {
+
+    namespace {
+
+        using Clock = std::chrono::steady_clock;
+
+        double milliseconds(const Clock::duration duration) {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+
+        double percentile(std::vector<Clock::duration> &samples, const double fraction) {
+            std::ranges::sort(samples);
+            const auto index = static_cast<std::size_t>(fraction * static_cast<double>(samples.size() - 1));
+            return milliseconds(samples[index]);
+        }
+
+        bool hash_once() { return security::Hasher::hash<security::Argon2id>("prapancha-benchmark").has_value(); }
+
+        void run(const std::uint32_t threads, const std::size_t hashes, const std::size_t callers,
+                 const std::chrono::milliseconds target) {
+            // Enough pool threads for every caller to get its share, so throughput is not capped by the pool.
+            if (!security::Hasher::set_argon2id_threads(threads, static_cast<std::uint64_t>(threads) * callers)) {
+                std::printf("%7u  thread pool unavailable\n", threads);
+                return;
+            }
+            std::vector<Clock::duration> samples;
+            samples.reserve(hashes);
+            for (std::size_t i = 0; i < hashes; ++i) {
+                const auto start = Clock::now();
+                if (!hash_once()) {
+                    std::printf("%7u  hash failed\n", threads);
+                    return;
+                }
+                samples.push_back(Clock::now() - start);
+            }
+            const auto start = Clock::now();
+            {
+                std::vector<std::jthread> workers;
+                for (std::size_t c = 0; c < callers; ++c) {
+                    workers.emplace_back([&, c] {
+                        for (std::size_t i = c; i < hashes; i += callers) {
+                            hash_once();
+                        }
+                    });
+                }
+            }
+            const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            const double per_second = static_cast<double>(hashes) / elapsed;
+            const auto calibration =
+                    security::Hasher::calibrate_argon2id({.latency = target, .max_memory = 1024 * 1024});
+            std::printf("%7u %9.1f %9.1f %11.1f", threads, percentile(samples, 0.5), percentile(samples, 0.99),
+                        per_second);
+            if (calibration) {
+                const auto &p = calibration->parameters;
+                std::printf("   m=%u KiB t=%u p=%u (%.1f ms%s)\n", p.m, p.t, p.p, milliseconds(calibration->latency),
+                            calibration->met ? "" : ", target missed");
+            } else {
+                std::printf("   calibration failed\n");
+            }
+        }
+
+    } // namespace
+
+} // namespace mehara::prapancha::bench
+
+int main(int argc, char *argv[]) {
+    using namespace mehara::prapancha;
+    const std::size_t hashes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    const std::size_t callers = argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+                                         : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    const std::chrono::milliseconds target{argc > 3 ? std::strtoll(argv[3], nullptr, 10) : 250};
+    if (hashes == 0 || callers == 0 || target.count() <= 0) {
+        std::fprintf(stderr, "Usage: %s [hashes] [callers] [target_ms]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const auto parameters = security::Hasher::argon2id_parameters();
+    std::printf("m=%u KiB t=%u p=%u, %zu hashes, %zu callers, %lld ms calibration target\n\n", parameters.m,
+                parameters.t, parameters.p, hashes, callers, static_cast<long long>(target.count()));
+    std::printf("%7s %9s %9s %11s   %s\n", "threads", "p50 ms", "p99 ms", "hashes/s", "calibrated");
+    for (const std::uint32_t threads: {1u, 2u, 4u, 8u}) {
+        bench::run(threads, hashes, callers, target);
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <openssl/evp.h>
+
+#include <prapancha/security/algorithms.h>
+
+/// Measures what the cached algorithms and per-thread contexts in security::algorithms save: fetching an algorithm
+/// once instead of on every call, and reusing a thread's digest context instead of allocating one per digest.
+///
+/// Usage: openssl_benchmark [iterations]
+namespace mehara::prapancha::bench {
+
+    namespace {
+
+        using Clock = std::chrono::steady_clock;
+
+        std::array<unsigned char, 64> input{};
+        std::array<unsigned char, EVP_MAX_MD_SIZE> output{};
+
+        template<typename Operation>
+        double nanoseconds_per_call(const std::size_t iterations, Operation &&operation) {
+            std::size_t failures = 0;
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < iterations; ++i) {
+                failures += operation() ? 0 : 1;
+            }
+            const auto elapsed = Clock::now() - start;
+            if (failures != 0) {
+                std::fprintf(stderr, "%zu of %zu calls failed\n", failures, iterations);
+            }
+            return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+        }
+
+        void report(const char *name, const double before, const double after) {
+            std::printf("%-30s %12.1f ns %12.1f ns %8.1fx\n", name, before, after, before / after);
+        }
+
+        bool digest(EVP_MD_CTX *ctx, const EVP_MD *md) {
+            unsigned int length = 0;
+            return ctx && EVP_DigestInit_ex2(ctx, md, nullptr) == 1 &&
+                   EVP_DigestUpdate(ctx, input.data(), input.size()) == 1 &&
+                   EVP_DigestFinal_ex(ctx, output.data(), &length) == 1;
+        }
+
+    } // namespace
+
+} // namespace mehara::prapancha::bench
+
+int main(int argc, char *argv[]) {
+    using namespace mehara::prapancha;
+    using namespace mehara::prapancha::bench;
+    namespace algorithms = security::algorithms;
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    if (iterations == 0) {
+        std::fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    std::printf("%zu iterations, %zu-byte digest input\n\n", iterations, input.size());
+    std::printf("%-30s %15s %15s %9s\n", "case", "before", "after", "speedup");
+
+    report("fetch SHA-256",
+           nanoseconds_per_call(iterations,
+                                [] {
+                                    EVP_MD *md = EVP_MD_fetch(nullptr, "SHA256", nullptr);
+                                    EVP_MD_free(md);
+                                    return md != nullptr;
+                                }),
+           nanoseconds_per_call(iterations, [] { return algorithms::sha256() != nullptr; }));
+
+    report("fetch AES-256-GCM",
+           nanoseconds_per_call(iterations,
+                                [] {
+                                    EVP_CIPHER *cipher = EVP_CIPHER_fetch(nullptr, "AES-256-GCM", nullptr);
+                                    EVP_CIPHER_free(cipher);
+                                    return cipher != nullptr;
+                                }),
+           nanoseconds_per_call(iterations, [] { return algorithms::aes_256_gcm() != nullptr; }));
+
+    report("SHA-256, EVP_Q_digest",
+           nanoseconds_per_call(iterations,
+                                [] {
+                                    return EVP_Q_digest(nullptr, "SHA256", nullptr, input.data(), input.size(),
+                                                        output.data(), nullptr) == 1;
+                                }),
+           nanoseconds_per_call(iterations, [] { return digest(algorithms::digest_context(), algorithms::sha256()); }));
+
+    report("SHA-256, fresh EVP_MD_CTX",
+           nanoseconds_per_call(iterations,
+                                [] {
+                                    EVP_MD_CTX *ctx = EVP_MD_CTX_new();
+                                    const bool done = digest(ctx, algorithms::sha256());
+                                    EVP_MD_CTX_free(ctx);
+                                    return done;
+                                }),
+           nanoseconds_per_call(iterations, [] { return digest(algorithms::digest_context(), algorithms::sha256()); }));
+    return 0;
+}
@@ -0,0 +1,117 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <prapancha/security/hasher.h>
+#include <prapancha/server/codec/json_codec.h>
+#include <prapancha/server/codec/json_model_codec.h>
+#include <prapancha/server/model.h>
+#include <prapancha/server/persistence/log_persistence.h>
+#include <prapancha/server/persistence/persistence.h>
+
+/// Saves, overwrites and loads the same user identities through FilePersistence and through LogPersistence at each
+/// durability level, with several writers at once.
+///
+/// Usage: persistence_benchmark [records] [writers] [directory]
+namespace mehara::prapancha::bench {
+
+    namespace {
+
+        using Identity = UserIdentity<security::Sha256>;
+        using Codec = codec::JsonCodec<Identity>;
+        using Clock = std::chrono::steady_clock;
+
+        /// Runs `work(i)` for every i below `count`, split evenly across `threads`, and returns the seconds it took.
+        double timed(const std::size_t count, const std::size_t threads,
+                     const std::function<void(std::size_t)> &work) {
+            const auto start = Clock::now();
+            std::vector<std::jthread> workers;
+            workers.reserve(threads);
+            for (std::size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    for (std::size_t i = t; i < count; i += threads) {
+                        work(i);
+                    }
+                });
+            }
+            workers.clear();
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        template<typename P>
+        void run(const std::string_view name, P persistence, const std::vector<Identity> &identities,
+                 const std::vector<Identity> &updates, const std::size_t writers) {
+            const std::size_t count = identities.size();
+            const double inserted =
+                    timed(count, writers, [&](const std::size_t i) { persistence.save(identities[i]); });
+            const double updated = timed(count, writers, [&](const std::size_t i) { persistence.save(updates[i]); });
+            std::size_t found = 0;
+            const double loaded = timed(count, 1, [&](const std::size_t i) {
+                found += persistence.load(identities[i].id()).has_value() ? 1 : 0;
+            });
+            std::printf("%-22s %12.0f %12.0f %12.0f%s\n", name.data(), count / inserted, count / updated,
+                        count / loaded, found == count ? "" : "  (records missing)");
+        }
+
+        persistence::SegmentLog::Options durable(const persistence::SegmentLog::Durability durability) {
+            persistence::SegmentLog::Options options;
+            options.durability = durability;
+            return options;
+        }
+
+    } // namespace
+
+} // namespace mehara::prapancha::bench
+
+int main(int argc, char *argv[]) {
+    using namespace mehara::prapancha;
+    using namespace mehara::prapancha::bench;
+    const std::size_t records = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000;
+    const std::size_t writers = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 8;
+    const std::filesystem::path root =
+            argc > 3 ? std::filesystem::path(argv[3])
+                     : std::filesystem::temp_directory_path() / "prapancha-persistence-benchmark";
+    if (records == 0 || writers == 0) {
+        std::fprintf(stderr, "Usage: %s [records] [writers] [directory]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    // One binding for every record keeps hashing out of the measurement.
+    const auto binding = security::Hasher::hash<security::Sha256>("benchmark");
+    if (!binding) {
+        std::fprintf(stderr, "Failed to hash the benchmark password.\n");
+        return EXIT_FAILURE;
+    }
+    std::vector<Identity> identities;
+    std::vector<Identity> updates;
+    identities.reserve(records);
+    updates.reserve(records);
+    for (std::size_t i = 0; i < records; ++i) {
+        identities.push_back(Identity::create({std::format("user-{}", i), *binding, false}));
+        updates.push_back(identities.back().patch({std::format("user-{}", i), *binding, true}));
+    }
+    std::filesystem::remove_all(root);
+    std::printf("%zu records, %zu writers, in %s\n\n", records, writers, root.c_str());
+    std::printf("%-22s %12s %12s %12s\n", "engine", "inserts/s", "updates/s", "loads/s");
+    using enum persistence::SegmentLog::Durability;
+    run("file", FilePersistence<Identity, Codec>(root / "file"), identities, updates, writers);
+    run("log (no sync)", LogPersistence<Identity, Codec>(root / "log-none", durable(None)), identities, updates,
+        writers);
+    run("log (group commit)", LogPersistence<Identity, Codec>(root / "log-batched", durable(Batched)), identities,
+        updates, writers);
+    run("log (sync per write)", LogPersistence<Identity, Codec>(root / "log-per-write", durable(PerWrite)),
+        identities, updates, writers);
+    std::filesystem::remove_all(root);
+    return 0;
+}
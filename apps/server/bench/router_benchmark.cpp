@@ -0,0 +1,133 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <format>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <prapancha/server/http.h>
+#include <prapancha/server/responder.h>
+#include <prapancha/server/route_index.h>
+#include <prapancha/server/router.h>
+
+/// Resolves requests against a few hundred synthetic routes, with Router's perfect hashes and with a linear scan that
+/// compares the target against every route in turn, as Router did before it was indexed.
+namespace mehara::prapancha::bench {
+
+    namespace {
+
+        constexpr std::size_t literal_count = 256;
+        constexpr std::size_t pattern_count = 64;
+        constexpr std::size_t iterations = 2'000'000;
+
+        template<std::size_t N>
+        consteval void number(char (&path)[N], const std::size_t offset, const std::size_t value) {
+            path[offset] = static_cast<char>('0' + value / 100);
+            path[offset + 1] = static_cast<char>('0' + value / 10 % 10);
+            path[offset + 2] = static_cast<char>('0' + value % 10);
+        }
+
+        template<std::size_t I>
+        consteval auto literal_path() {
+            char path[] = "/api/v1/resources/000";
+            number(path, 18, I);
+            return Path(path);
+        }
+
+        template<std::size_t I>
+        consteval auto pattern_path() {
+            char path[] = "/api/v1/items/000/{id}";
+            number(path, 14, I);
+            return Path(path);
+        }
+
+        void respond(http::RequestView, http::Responder &&) {}
+
+        template<typename Literals, typename Patterns>
+        struct Table;
+
+        template<std::size_t... L, std::size_t... P>
+        struct Table<std::index_sequence<L...>, std::index_sequence<P...>> {
+            using Indexed = Router<Route<literal_path<L>(), http::Method::Get, respond>...,
+                                   Route<pattern_path<P>(), http::Method::Get, respond>...>;
+
+            static constexpr std::array<std::string_view, sizeof...(L) + sizeof...(P)> paths{
+                    Route<literal_path<L>(), http::Method::Get, respond>::path...,
+                    Route<pattern_path<P>(), http::Method::Get, respond>::path...};
+        };
+
+        using Synthetic = Table<std::make_index_sequence<literal_count>, std::make_index_sequence<pattern_count>>;
+
+        /// Route index a linear scan finds, or the route count if none serves the method.
+        std::size_t linear(const http::Method method, const std::string_view target) {
+            http::PathParameters::Values values{};
+            for (std::size_t i = 0; i < Synthetic::paths.size(); ++i) {
+                const auto path = Synthetic::paths[i];
+                if ((routing::is_parameterized(path) ? routing::match(path, target, values) : path == target) &&
+                    method == http::Method::Get) {
+                    return i;
+                }
+            }
+            return Synthetic::paths.size();
+        }
+
+        struct Request {
+            http::Method method;
+            std::string target;
+        };
+
+        template<typename Lookup>
+        double nanoseconds_per_lookup(const std::vector<Request> &requests, Lookup &&lookup) {
+            std::size_t sink = 0;
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < iterations; ++i) {
+                const auto &request = requests[i % requests.size()];
+                sink += lookup(request.method, request.target);
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            static volatile std::size_t keep;
+            keep = sink;
+            return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+        }
+
+        void run(const char *name, const std::vector<Request> &requests) {
+            const double indexed = nanoseconds_per_lookup(requests, [](const http::Method method, const auto &target) {
+                return Synthetic::Indexed::body_limit(method, target).bytes;
+            });
+            const double scanned = nanoseconds_per_lookup(requests, linear);
+            std::printf("%-18s %10.1f ns %10.1f ns %8.1fx\n", name, indexed, scanned, scanned / indexed);
+        }
+
+    } // namespace
+
+} // namespace mehara::prapancha::bench
+
+int main() {
+    using namespace mehara::prapancha;
+    using namespace mehara::prapancha::bench;
+    std::mt19937 random(42);
+    std::uniform_int_distribution<std::size_t> literal(0, literal_count - 1);
+    std::uniform_int_distribution<std::size_t> pattern(0, pattern_count - 1);
+    std::vector<Request> literals, patterns, misses, mismatches;
+    for (std::size_t i = 0; i < 1024; ++i) {
+        literals.push_back({http::Method::Get, std::format("/api/v1/resources/{:03}", literal(random))});
+        patterns.push_back({http::Method::Get, std::format("/api/v1/items/{:03}/{}", pattern(random), i)});
+        misses.push_back({http::Method::Get, std::format("/api/v1/missing/{:03}", literal(random))});
+        mismatches.push_back({http::Method::Post, std::format("/api/v1/resources/{:03}", literal(random))});
+    }
+    std::printf("%zu literal routes, %zu patterns, %zu lookups per case\n\n", literal_count, pattern_count, iterations);
+    std::printf("%-18s %13s %13s %9s\n", "case", "indexed", "linear", "speedup");
+    run("literal hit", literals);
+    run("pattern hit", patterns);
+    run("unknown path", misses);
+    run("method mismatch", mismatches);
+    return 0;
+}
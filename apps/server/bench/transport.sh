@@ -0,0 +1,74 @@
+#!/usr/bin/env bash
+#
+# Created by Aman Mehara on 17/10/26.
+#
+# Compares the Asio (epoll) and io_uring transports under the same load. Each transport is started in turn, driven by
+# wrk at every connection count, and traced with perf for the syscalls it makes while serving. Reports throughput,
+# tail latency and syscalls per request.
+#
+# Usage: transport.sh <path/to/prapancha> [connections...]
+#   THREADS    executor threads for the server and wrk (default: nproc / 2)
+#   DURATION   seconds per run (default: 15)
+#   PORT       listener port (default: 18080)
+#   TARGET     request path (default: /api/v1/status)
+#
+# Requires curl, wrk and perf; perf needs permission to trace the server (perf_event_paranoid <= 1 or root).
+
+set -euo pipefail
+
+if [[ $# -lt 1 ]]; then
+    sed -n '4,15p' "$0" | sed 's/^# \{0,1\}//'
+    exit 1
+fi
+
+server=$(realpath "$1")
+shift
+if [[ $# -gt 0 ]]; then
+    connections=("$@")
+else
+    connections=(64 1024 8192)
+fi
+threads=${THREADS:-$(( $(nproc) / 2 > 0 ? $(nproc) / 2 : 1 ))}
+duration=${DURATION:-15}
+port=${PORT:-18080}
+target=${TARGET:-/api/v1/status}
+
+for tool in curl wrk perf; do
+    command -v "$tool" > /dev/null || { echo "transport.sh: $tool not found" >&2; exit 1; }
+done
+
+data=$(mktemp -d)
+trap 'kill "${pid:-}" 2> /dev/null || true; rm -rf "$data"' EXIT
+ulimit -n 65536 2> /dev/null || true
+
+printf '%-9s %7s %12s %9s %9s %9s %14s\n' transport conns requests/s p50 p90 p99 syscalls/req
+
+for transport in asio io_uring; do
+    for conns in "${connections[@]}"; do
+        "$server" "--$transport" --port "$port" --thread_count "$threads" --data_path "$data/$transport" \
+            --max_requests 1000000 > "$data/server.log" 2>&1 &
+        pid=$!
+        for _ in $(seq 50); do
+            curl -fs "http://127.0.0.1:$port$target" > /dev/null 2>&1 && break
+            sleep 0.1
+        done
+        # Warm up, so connection setup and first-use initialization stay out of the measured run.
+        wrk -t "$threads" -c "$conns" -d 2 "http://127.0.0.1:$port$target" > /dev/null
+        perf stat -e raw_syscalls:sys_enter -x, -o "$data/perf.csv" -p "$pid" -- sleep "$duration" &
+        perf_pid=$!
+        wrk -t "$threads" -c "$conns" -d "$duration" --latency "http://127.0.0.1:$port$target" > "$data/wrk.txt"
+        wait "$perf_pid"
+        kill -INT "$pid"
+        wait "$pid" || true
+
+        requests=$(awk '/requests in/ { print $1 }' "$data/wrk.txt")
+        rate=$(awk '/Requests\/sec/ { print $2 }' "$data/wrk.txt")
+        p50=$(awk '$1 == "50%" { print $2 }' "$data/wrk.txt")
+        p90=$(awk '$1 == "90%" { print $2 }' "$data/wrk.txt")
+        p99=$(awk '$1 == "99%" { print $2 }' "$data/wrk.txt")
+        syscalls=$(awk -F, '/raw_syscalls:sys_enter/ { print $1 }' "$data/perf.csv")
+        per_request=$(awk -v s="$syscalls" -v r="$requests" 'BEGIN { printf "%.3f", r > 0 ? s / r : 0 }')
+        printf '%-9s %7s %12s %9s %9s %9s %14s\n' "$transport" "$conns" "$rate" "$p50" "$p90" "$p99" \
+            "$per_request"
+    done
+done
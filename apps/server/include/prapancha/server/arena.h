@@ -0,0 +1,66 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_ARENA_H_
+#define PRAPANCHA_SERVER_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+
+namespace mehara::prapancha {
+
+    /// Arena Class
+    ///
+    /// Monotonic memory resource backing a single request's lifecycle: the parsed message, its header fields, the
+    /// handler's response and the serializer's scratch space. Deallocation is a no-op; everything is reclaimed at
+    /// once by reset() when the response has been written. Requests that outgrow the initial block spill over to
+    /// the global heap and are counted as overflows, which is the signal to raise `arena_size`.
+    class Arena final : public std::pmr::memory_resource {
+    public:
+        /// Process-wide totals across every arena, updated once per request.
+        struct Statistics {
+            std::atomic<std::uint64_t> requests{0};
+            std::atomic<std::uint64_t> bytes{0};
+            std::atomic<std::uint64_t> peak{0};
+            std::atomic<std::uint64_t> overflows{0};
+        };
+
+    private:
+        std::size_t capacity_;
+        std::unique_ptr<std::byte[]> initial_;
+        std::pmr::monotonic_buffer_resource resource_;
+        std::size_t used_ = 0;
+
+    public:
+        explicit Arena(std::size_t capacity);
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        /// Bytes handed out since the last reset.
+        [[nodiscard]] std::size_t used() const noexcept;
+
+        [[nodiscard]] std::size_t capacity() const noexcept;
+
+        /// Releases every allocation, records the finished request in statistics() and returns the bytes it used.
+        std::size_t reset() noexcept;
+
+        [[nodiscard]] static Statistics &statistics() noexcept;
+
+    private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+        void do_deallocate(void *, std::size_t, std::size_t) noexcept override {}
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+} // namespace mehara::prapancha
+
+#endif // PRAPANCHA_SERVER_ARENA_H_
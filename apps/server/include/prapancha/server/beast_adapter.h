@@ -5,17 +5,28 @@
 #ifndef PRAPANCHA_SERVER_BEAST_ADAPTER_H_
 #define PRAPANCHA_SERVER_BEAST_ADAPTER_H_
 
+#include <memory_resource>
+
 #include <boost/beast/http.hpp>
 #include <prapancha/server/http.h>
 
 namespace mehara::prapancha::http {
 
+    /// @brief Beast request whose body and fields are both allocated from the request's arena.
+    using BeastRequest = boost::beast::http::request<
+            boost::beast::http::vector_body<uint8_t, std::pmr::polymorphic_allocator<uint8_t>>, Fields>;
+
     [[nodiscard]] Method from_beast(boost::beast::http::verb beast_verb) noexcept;
 
-    [[nodiscard]] Request
-    from_beast(boost::beast::http::request<boost::beast::http::vector_body<uint8_t>> &beast_request);
+    [[nodiscard]] RequestView from_beast(const BeastRequest &beast_request, Arena *arena) noexcept;
+
+    /// View of a request whose body has not been read yet, as handed to streaming routes.
+    [[nodiscard]] RequestView from_beast(const boost::beast::http::request_header<Fields> &beast_header,
+                                         Arena *arena) noexcept;
 
-    [[nodiscard]] boost::beast::http::response<boost::beast::http::string_body> to_beast(Response &&response);
+    [[nodiscard]] boost::beast::http::response_header<Fields> to_beast(Status status,
+                                                                       const std::pmr::vector<Header> &headers,
+                                                                       Allocator alloc);
 
 } // namespace mehara::prapancha::http
 
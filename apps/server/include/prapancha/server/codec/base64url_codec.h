@@ -0,0 +1,85 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_CODEC_BASE64URL_CODEC_H_
+#define PRAPANCHA_CODEC_BASE64URL_CODEC_H_
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <prapancha/server/codec/codec.h>
+
+namespace mehara::prapancha::codec {
+
+    inline constexpr std::string_view base64url_chars =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+    template<typename T>
+    struct Base64UrlCodec;
+
+    /// URL-safe base64 without padding (RFC 4648 §5), as carried by the HTTP2-Settings header.
+    template<>
+    struct Base64UrlCodec<std::vector<std::uint8_t>> {
+        using encoded_type = std::string;
+        using encoded_view = std::string_view;
+
+        static encoded_type encode(const std::vector<std::uint8_t> &bytes) {
+            std::string result;
+            result.reserve((bytes.size() * 4 + 2) / 3);
+            std::uint32_t bits = 0;
+            int count = 0;
+            for (const std::uint8_t byte: bytes) {
+                bits = bits << 8 | byte;
+                count += 8;
+                while (count >= 6) {
+                    count -= 6;
+                    result.push_back(base64url_chars[bits >> count & 0x3F]);
+                }
+            }
+            if (count > 0) {
+                result.push_back(base64url_chars[bits << (6 - count) & 0x3F]);
+            }
+            return result;
+        }
+
+        /// Empty if `data` holds a character outside the alphabet, padding, or a length no encoding produces.
+        static std::optional<std::vector<std::uint8_t>> decode(encoded_view data) {
+            if (data.length() % 4 == 1) {
+                return std::nullopt;
+            }
+            static constexpr auto values = [] {
+                std::array<std::int8_t, 256> table{};
+                table.fill(-1);
+                for (std::size_t i = 0; i < base64url_chars.size(); ++i) {
+                    table[static_cast<unsigned char>(base64url_chars[i])] = static_cast<std::int8_t>(i);
+                }
+                return table;
+            }();
+            std::vector<std::uint8_t> bytes;
+            bytes.reserve(data.length() * 3 / 4);
+            std::uint32_t bits = 0;
+            int count = 0;
+            for (const char c: data) {
+                const std::int8_t value = values[static_cast<unsigned char>(c)];
+                if (value < 0) {
+                    return std::nullopt;
+                }
+                bits = bits << 6 | static_cast<std::uint32_t>(value);
+                count += 6;
+                if (count >= 8) {
+                    count -= 8;
+                    bytes.push_back(static_cast<std::uint8_t>(bits >> count));
+                }
+            }
+            return bytes;
+        }
+    };
+
+} // namespace mehara::prapancha::codec
+
+#endif // PRAPANCHA_CODEC_BASE64URL_CODEC_H_
@@ -0,0 +1,36 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_COMPUTE_H_
+#define PRAPANCHA_SERVER_COMPUTE_H_
+
+#include <cstddef>
+
+#include <boost/asio/thread_pool.hpp>
+
+/// @brief Thread pool that keeps CPU-bound handler work off the I/O threads.
+///
+/// Awaitable handlers are spawned here, so a burst of password hashing occupies compute threads while every I/O
+/// thread keeps serving the connections it owns. Responses still leave through the request's Responder, which hands
+/// them back to the connection's own executor.
+namespace mehara::prapancha::compute {
+
+    using Executor = boost::asio::thread_pool::executor_type;
+
+    /// Starts the pool. A thread count of zero sizes it to half the hardware threads, at least one. Later calls are
+    /// ignored.
+    void initialize(int thread_count);
+
+    /// Executor of the pool; initialize() must have been called.
+    [[nodiscard]] Executor executor() noexcept;
+
+    /// Threads the pool was started with, zero before initialize().
+    [[nodiscard]] std::size_t thread_count() noexcept;
+
+    /// Waits for queued work to finish and joins the pool's threads.
+    void shutdown() noexcept;
+
+} // namespace mehara::prapancha::compute
+
+#endif // PRAPANCHA_SERVER_COMPUTE_H_
@@ -5,6 +5,7 @@
 #ifndef PRAPANCHA_SERVER_CONFIGURATION_H_
 #define PRAPANCHA_SERVER_CONFIGURATION_H_
 
+#include <cstdint>
 #include <limits>
 #include <string>
 #include <string_view>
@@ -25,28 +26,114 @@ namespace mehara::prapancha::configuration {
 
         /// @brief Network-specific settings for the Prapancha listener.
         struct Network {
+            /// @brief Defines how connections are spread across executor threads.
+            enum class Execution {
+                Shared, ///< One io_context and one acceptor shared by all threads; connections run on strands.
+                Sharded ///< One io_context, pinned thread and SO_REUSEPORT acceptor per core; no strands.
+            };
+
+            /// @brief Defines the kernel interface used for socket I/O.
+            enum class Transport {
+                Asio, ///< Boost.Asio readiness model (epoll on Linux); supports every protocol and execution mode.
+                IoUring ///< Completion-based io_uring rings, one per pinned thread; HTTP/1.1 only, always sharded.
+            };
+
             static constexpr std::string_view DefaultHost = "127.0.0.1"; ///< Listens on all available interfaces.
             static constexpr uint16_t DefaultPort = 8080; ///< Fallback port if none is provided.
             static constexpr int AutoDetectThreads = 0; ///< Sentinel to trigger hardware concurrency detection.
+            static constexpr std::uint32_t DefaultMaxRequestsPerConnection = 1000; ///< Requests served per connection.
+            static constexpr std::uint32_t DefaultKeepAliveTimeout = 30; ///< Idle seconds before a connection closes.
+            static constexpr std::uint32_t DefaultPipelineDepth = 1; ///< One request in flight; pipelining disabled.
+            static constexpr std::uint32_t DefaultArenaSize = 16 * 1024; ///< Per-request arena block in bytes.
+            static constexpr std::uint32_t DefaultMaxConcurrentStreams = 256; ///< HTTP/2 streams open per connection.
+            static constexpr std::uint32_t DefaultTlsSessionCache = 20 * 1024; ///< Server-side TLS sessions kept.
+            static constexpr std::uint32_t DefaultTlsTickets = 2; ///< TLS 1.3 tickets issued per full handshake.
             std::string host = std::string(DefaultHost); ///< Binding address for the server.
             uint16_t port = DefaultPort; ///< Listener port number.
             int thread_count = AutoDetectThreads; ///< Number of worker threads for the request pool.
+            std::uint32_t max_requests_per_connection = DefaultMaxRequestsPerConnection; ///< Keep-alive request cap.
+            std::uint32_t keep_alive_timeout = DefaultKeepAliveTimeout; ///< Keep-alive idle timeout in seconds.
+            std::uint32_t pipeline_depth = DefaultPipelineDepth; ///< Requests parsed ahead per connection.
+            std::uint32_t arena_size = DefaultArenaSize; ///< Initial arena bytes per in-flight request.
+            std::uint32_t max_concurrent_streams = DefaultMaxConcurrentStreams; ///< HTTP/2 stream multiplexing cap.
+            std::string tls_certificate; ///< PEM certificate chain; TLS is enabled together with a private key.
+            std::string tls_private_key; ///< PEM private key matching tls_certificate.
+            std::uint32_t tls_session_cache = DefaultTlsSessionCache; ///< Resumable sessions held in memory.
+            std::uint32_t tls_tickets = DefaultTlsTickets; ///< Session tickets sent after each full handshake.
+            Execution execution = Execution::Shared; ///< Threading model for the listener and sessions.
+            Transport transport = Transport::Asio; ///< Socket I/O backend selected at startup.
+        };
+
+        /// @brief Settings for the thread pool that runs CPU-bound handler work away from the I/O threads.
+        struct Compute {
+            static constexpr int AutoDetectThreads = 0; ///< Sentinel for half the hardware threads, at least one.
+            int thread_count = AutoDetectThreads; ///< Threads available to awaitable handlers.
+        };
+
+        /// @brief Settings for the Argon2id hashing service that bounds password hashing by memory.
+        struct Hashing {
+            static constexpr std::uint32_t DefaultQueueCapacity = 64; ///< Hashes waiting before new ones are refused.
+            static constexpr std::uint32_t DefaultMemoryBudget = 1024; ///< MiB all running hashes may hold together.
+            static constexpr std::uint32_t DefaultArgon2Threads = 4; ///< One per Argon2id lane.
+            static constexpr std::uint32_t DefaultArgon2MaxMemory = 256; ///< MiB calibration may give one hash.
+            std::uint32_t workers = 0; ///< Hashing threads; 0 sizes the pool to the hardware threads.
+            std::uint32_t queue_capacity = DefaultQueueCapacity; ///< Bounded queue length.
+            std::uint32_t memory_budget = DefaultMemoryBudget; ///< Memory budget in MiB.
+            std::uint32_t argon2_threads = DefaultArgon2Threads; ///< OpenSSL pool threads one hash may use.
+            std::uint32_t argon2_max_threads = 0; ///< OpenSSL pool size; 0 sizes it to the hardware threads.
+            std::uint32_t argon2_latency = 0; ///< Calibration target per hash in ms; 0 keeps the built-in costs.
+            std::uint32_t argon2_max_memory = DefaultArgon2MaxMemory; ///< Calibration memory ceiling in MiB.
         };
 
         /// @brief Settings related to the framework's filesystem storage layer.
         struct Persistence {
+            /// @brief How records are laid out on disk.
+            enum class Engine {
+                File, ///< One file per record, rewritten on every save.
+                Log ///< Append-only segment files with an in-memory index and background compaction.
+            };
+
+            /// @brief When a log write is acknowledged; the file engine never flushes.
+            enum class Durability {
+                None, ///< Once written to the page cache.
+                Batched, ///< Once the group commit it joined has been flushed with one fdatasync.
+                PerWrite ///< Once flushed on its own.
+            };
+
             static constexpr std::string_view DefaultRootPath = "./data"; ///< Default relative storage path.
+            static constexpr std::uint32_t DefaultSegmentSize = 64; ///< MiB after which a log segment is sealed.
+            static constexpr std::uint32_t DefaultCacheMemory = 32; ///< MiB of decoded models kept in memory.
             std::string root_path = std::string(DefaultRootPath); ///< Filesystem path for persistent data.
+            Engine engine = Engine::File; ///< Storage engine selected at startup.
+            std::uint32_t segment_size = DefaultSegmentSize; ///< Log segment size in MiB.
+            Durability durability = Durability::Batched; ///< Flushing policy of the log engine.
+            std::uint32_t cache_memory = DefaultCacheMemory; ///< Cache budget per store in MiB; 0 disables caching.
         };
 
         Environment environment = Environment::Development; ///< Current operational environment.
         Network network; ///< Instance of network configuration settings.
+        Compute compute; ///< Instance of compute pool settings.
+        Hashing hashing; ///< Instance of hashing service settings.
         Persistence persistence; ///< Instance of persistence storage settings.
 
         /// @brief Checks if the system is running in Production mode.
         /// @return true if environment is set to Production.
         [[nodiscard]] bool is_production() const noexcept { return environment == Environment::Production; }
 
+        /// @brief Checks if the listener runs one pinned shard per core.
+        /// @return true if network execution is set to Sharded.
+        [[nodiscard]] bool is_sharded() const noexcept { return network.execution == Network::Execution::Sharded; }
+
+        /// @brief Checks if sockets are driven by io_uring instead of Asio.
+        /// @return true if network transport is set to IoUring.
+        [[nodiscard]] bool is_io_uring() const noexcept { return network.transport == Network::Transport::IoUring; }
+
+        /// @brief Checks if connections are terminated with TLS.
+        /// @return true if both a certificate chain and a private key are configured.
+        [[nodiscard]] bool is_tls() const noexcept {
+            return !network.tls_certificate.empty() && !network.tls_private_key.empty();
+        }
+
         /// @brief Checks if the system is running in Development mode.
         /// @return true if environment is set to Development.
         [[nodiscard]] bool is_development() const noexcept { return environment == Environment::Development; }
@@ -6,12 +6,21 @@
 #define PRAPANCHA_SERVER_CONTROLLER_BASE_CONTROLLER_H_
 
 #include <concepts>
+#include <exception>
 #include <memory>
+#include <memory_resource>
+#include <string>
 #include <string_view>
+#include <type_traits>
 
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+
+#include <prapancha/server/compute.h>
 #include <prapancha/server/http.h>
 #include <prapancha/server/logger_registry.h>
 #include <prapancha/server/policy/policy.h>
+#include <prapancha/server/responder.h>
 
 namespace mehara::prapancha {
 
@@ -21,31 +30,91 @@ namespace mehara::prapancha {
         typename std::tuple_size<typename T::RequiredTraits>::type;
     };
 
+    /// A handler that builds its response on the thread that dispatched the request.
+    template<typename T, typename Context>
+    concept SynchronousHandler = requires(T &controller, Context ctx, http::Responder sender) {
+        { controller.handle(std::move(ctx), std::move(sender)) } -> std::same_as<void>;
+    };
+
+    /// A coroutine handler, spawned on the compute pool so that it may block on CPU-bound work without holding up
+    /// an I/O thread. It takes its context and responder by value, since both must outlive the dispatching call.
+    template<typename T, typename Context>
+    concept AwaitableHandler = requires(T &controller, Context ctx, http::Responder sender) {
+        { controller.handle(std::move(ctx), std::move(sender)) } -> std::same_as<boost::asio::awaitable<void>>;
+    };
+
     template<typename T>
     class BaseController : std::enable_shared_from_this<T> {
+        static std::string describe(const std::exception_ptr &error) {
+            try {
+                std::rethrow_exception(error);
+            } catch (const std::exception &e) {
+                return e.what();
+            } catch (...) {
+                return "unknown exception";
+            }
+        }
+
+        /// Runs an awaitable handler and answers 500 if it throws before responding. The handler is handed a responder
+        /// that forwards to `sender` in this frame, so it must respond, or give up its responder, before it completes.
+        template<typename Context>
+        boost::asio::awaitable<void> guarded(Context ctx, http::Responder sender, std::pmr::memory_resource *arena) {
+            try {
+                co_await static_cast<T *>(this)->handle(std::move(ctx),
+                                                        http::Responder{[slot = &sender](http::Response &&response) {
+                                                            auto owner = std::move(*slot);
+                                                            owner(std::move(response));
+                                                        }});
+                co_return;
+            } catch (...) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: [{}] handler failed: {}.", T::controller_name,
+                                         describe(std::current_exception()));
+            }
+            if (sender) {
+                sender(http::Response{http::Status::InternalServerError, "प्रपञ्च — Prapancha: Internal Server Error!",
+                                      arena});
+            }
+        }
+
     public:
-        template<typename Sender>
-        void dispatch(http::Request &&request, Sender &&sender) {
+        void dispatch(http::RequestView request, http::Responder &&sender) {
             static_assert(Controller<T>, "Controller concept not satisfied.");
-            Loggers::App().log_info([&] {
+            Loggers::App().log_debug([&] {
                 return std::format("Dispatch [{}] {} {} ({} bytes).", T::controller_name,
                                    http::get_traits(request.method).name, request.target, request.body.size());
             });
             using Traits = T::RequiredTraits;
-            auto runner = [this, sender = std::forward<Sender>(sender)]<size_t I>(this auto &&self, auto &&ctx) {
+            // Policies may consume the view; the arena outlives them and backs every response for this request.
+            auto runner = [this, arena = request.arena,
+                           sender = std::move(sender)]<size_t I>(this auto &&self, auto &&ctx) {
                 if constexpr (I == std::tuple_size_v<Traits>) {
-                    static_cast<T *>(this)->handle(std::forward<decltype(ctx)>(ctx), std::move(sender));
+                    using Context = std::remove_cvref_t<decltype(ctx)>;
+                    static_assert(SynchronousHandler<T, Context> || AwaitableHandler<T, Context>,
+                                  "Controller handle must return void or boost::asio::awaitable<void>.");
+                    if constexpr (AwaitableHandler<T, Context>) {
+                        boost::asio::co_spawn(compute::executor(),
+                                              guarded(std::forward<decltype(ctx)>(ctx), std::move(sender), arena),
+                                              [](const std::exception_ptr &error) {
+                                                  if (error) {
+                                                      Loggers::App().log_error(
+                                                              "प्रपञ्च — Prapancha: [{}] handler failed: {}.",
+                                                              T::controller_name, describe(error));
+                                                  }
+                                              });
+                    } else {
+                        static_cast<T *>(this)->handle(std::forward<decltype(ctx)>(ctx), std::move(sender));
+                    }
                 } else {
                     using NextTrait = std::tuple_element_t<I, Traits>;
                     auto res = policy::PolicyFor<NextTrait>::execute(std::forward<decltype(ctx)>(ctx));
                     if (!res) {
-                        sender(http::Response{res.error(), {}, "Policy Violation!"});
+                        sender(http::Response{res.error(), "Policy Violation!", arena});
                         return;
                     }
                     std::forward<decltype(self)>(self).template operator()<I + 1>(std::move(*res));
                 }
             };
-            runner.template operator()<0>(std::move(request));
+            runner.template operator()<0>(request);
         }
     };
 
@@ -10,59 +10,60 @@
 #include <prapancha/server/controller/status_controller.h>
 #include <prapancha/server/controller/void_controller.h>
 #include <prapancha/server/persistence_registry.h>
+#include <prapancha/server/responder.h>
 
 namespace mehara::prapancha {
 
     class ControllerProvider {
     public:
-        static void root_controller(http::Request &&req, std::function<void(http::Response)> &&send) {
+        static void root_controller(http::RequestView req, http::Responder &&send) {
             static auto instance = std::make_shared<RootController>();
-            instance->dispatch(std::move(req), std::forward<decltype(send)>(send));
+            instance->dispatch(req, std::move(send));
         }
 
-        static void status_controller(http::Request &&req, std::function<void(http::Response)> &&send) {
+        static void status_controller(http::RequestView req, http::Responder &&send) {
             static auto instance = std::make_shared<StatusController>();
-            instance->dispatch(std::move(req), std::forward<decltype(send)>(send));
+            instance->dispatch(req, std::move(send));
         }
 
-        static void void_controller(http::Request &&req, std::function<void(http::Response)> &&send) {
+        static void void_controller(http::RequestView req, http::Responder &&send) {
             static auto instance = std::make_shared<VoidController>();
-            instance->dispatch(std::move(req), std::forward<decltype(send)>(send));
+            instance->dispatch(req, std::move(send));
         }
 
         struct Identity {
-            static void registration_controller(http::Request &&req, std::function<void(http::Response)> &&send) {
+            static void registration_controller(http::RequestView req, http::Responder &&send) {
                 std::visit(
                         [&]<typename Persistence>(Persistence &persistence) {
                             static RegistrationController<Persistence> instance(persistence);
-                            instance.dispatch(std::move(req), std::move(send));
+                            instance.dispatch(req, std::move(send));
                         },
                         *PersistenceRegistry::user_identity_persistence);
             }
 
-            static void deregistration_controller(http::Request &&req, std::function<void(http::Response)> &&send) {
+            static void deregistration_controller(http::RequestView req, http::Responder &&send) {
                 std::visit(
                         [&]<typename Persistence>(Persistence &persistence) {
                             static DeregistrationController<Persistence> instance(persistence);
-                            instance.dispatch(std::move(req), std::move(send));
+                            instance.dispatch(req, std::move(send));
                         },
                         *PersistenceRegistry::user_identity_persistence);
             }
 
-            static void login_controller(http::Request &&req, std::function<void(http::Response)> &&send) {
+            static void login_controller(http::RequestView req, http::Responder &&send) {
                 std::visit(
                         [&]<typename Persistence>(Persistence &persistence) {
                             static LoginController<Persistence> instance(persistence);
-                            instance.dispatch(std::move(req), std::move(send));
+                            instance.dispatch(req, std::move(send));
                         },
                         *PersistenceRegistry::user_identity_persistence);
             }
 
-            static void logout_controller(http::Request &&req, std::function<void(http::Response)> &&send) {
+            static void logout_controller(http::RequestView req, http::Responder &&send) {
                 std::visit(
                         [&]<typename Persistence>(Persistence &persistence) {
                             static LogoutController<Persistence> instance(persistence);
-                            instance.dispatch(std::move(req), std::move(send));
+                            instance.dispatch(req, std::move(send));
                         },
                         *PersistenceRegistry::user_identity_persistence);
             }
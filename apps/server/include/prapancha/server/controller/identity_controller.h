@@ -6,14 +6,20 @@
 #define PRAPANCHA_SERVER_CONTROLLER_IDENTITY_CONTROLLER_H_
 
 #include <algorithm>
+#include <concepts>
+#include <expected>
 #include <string>
 #include <string_view>
 #include <tuple>
 
+#include <boost/asio/use_awaitable.hpp>
+
 #include <prapancha/server/codec/binary_json_codec.h>
 #include <prapancha/server/controller/base_controller.h>
+#include <prapancha/server/hashing_registry.h>
 #include <prapancha/server/logger_registry.h>
 #include <prapancha/server/model.h>
+#include <prapancha/server/persistence/indexed_persistence.h>
 #include <prapancha/server/persistence/persistence.h>
 
 namespace mehara::prapancha {
@@ -21,32 +27,74 @@ namespace mehara::prapancha {
     template<typename Persistence>
     class RegistrationController : public BaseController<RegistrationController<Persistence>> {
         using HashAlgorithmType = Persistence::ModelType::HashAlgorithmType;
+        using State = Persistence::ModelType::State;
         Persistence persistence_;
 
+        /// Answers from the username index when the persistence keeps one; otherwise only save() can tell.
+        bool username_taken(const std::string &username) {
+            if constexpr (requires { persistence_.template contains<&State::username>(username); }) {
+                return persistence_.template contains<&State::username>(username);
+            } else {
+                return false;
+            }
+        }
+
+        static void refuse_username(http::Response &response) {
+            response.status = http::Status::Conflict;
+            response.body = "प्रपञ्च — Prapancha: Username Taken!";
+        }
+
+        static boost::asio::awaitable<std::expected<typename HashAlgorithmType::Binding, security::Error>>
+        hash_password(std::string password) {
+            if constexpr (std::same_as<HashAlgorithmType, security::Argon2id>) {
+                co_return co_await async_hash(std::move(password), boost::asio::use_awaitable);
+            } else {
+                co_return security::Hasher::hash<HashAlgorithmType>(password);
+            }
+        }
+
     public:
         explicit RegistrationController(Persistence persistence) : persistence_(std::move(persistence)) {}
         static constexpr std::string_view controller_name = "registration";
         using RequiredTraits = std::tuple<policy::WithRequest>;
 
-        void handle(auto &&ctx, auto &&sender) {
-            http::Response response;
+        /// Hashing the password dominates the request, so the handler runs on the compute pool and Argon2id waits its
+        /// turn on the hashing service.
+        boost::asio::awaitable<void> handle(auto ctx, http::Responder sender) {
+            http::Response response{http::Status::Ok, ctx.request.arena};
             response.set_header("Content-Type", "text/html; charset=utf-8");
             auto json_object_opt = codec::BinaryCodec<boost::json::object>::decode(ctx.request.body);
             if (!json_object_opt) {
                 response.status = http::Status::BadRequest;
                 response.body = "प्रपञ्च — Prapancha: Invalid Input!";
-                return sender(std::move(response));
+                sender(std::move(response));
+                co_return;
             }
             auto *username_ptr = json_object_opt->if_contains("username");
             auto *password_ptr = json_object_opt->if_contains("password");
             if (!username_ptr || !password_ptr || !username_ptr->is_string() || !password_ptr->is_string()) {
                 response.status = http::Status::UnprocessableEntity;
                 response.body = "प्रपञ्च — Prapancha: Invalid Input!";
-                return sender(std::move(response));
+                sender(std::move(response));
+                co_return;
             }
             std::string username{username_ptr->as_string()};
+            // Checked before hashing, so a taken username costs no Argon2id work.
+            if (username_taken(username)) {
+                refuse_username(response);
+                sender(std::move(response));
+                co_return;
+            }
             std::string password{password_ptr->as_string()};
-            auto password_binding = security::Hasher::hash<HashAlgorithmType>(password);
+            auto password_binding = co_await hash_password(std::move(password));
+            if (!password_binding && password_binding.error().retriable()) {
+                Loggers::App().log_warn("प्रपञ्च — Prapancha: Hashing saturated; registration refused.");
+                response.status = http::Status::ServiceUnavailable;
+                response.set_header("Retry-After", "1");
+                response.body = "प्रपञ्च — Prapancha: Service Unavailable!";
+                sender(std::move(response));
+                co_return;
+            }
             if (!password_binding) {
                 auto &error = password_binding.error();
                 Loggers::App().log_error([&] {
@@ -59,14 +107,26 @@ namespace mehara::prapancha {
                 });
                 response.status = http::Status::InternalServerError;
                 response.body = "प्रपञ्च — Prapancha: Internal Server Error!";
-                return sender(std::move(response));
+                sender(std::move(response));
+                co_return;
             }
             auto user_identity = UserIdentity<HashAlgorithmType>::create({username, *password_binding, false});
-            persistence_.save(user_identity);
+            // Another registration may have claimed the username while this one was hashing.
+            bool saved = true;
+            try {
+                persistence_.save(user_identity);
+            } catch (const persistence::IndexConflict &) {
+                saved = false;
+            }
+            if (!saved) {
+                refuse_username(response);
+                sender(std::move(response));
+                co_return;
+            }
             Loggers::App().log_info([&] { return std::format("Registration Successful! Username={}", username); });
             response.status = {http::Status::Created};
             response.body = "प्रपञ्च — Prapancha: Registration Successful!";
-            return sender(std::move(response));
+            sender(std::move(response));
         }
     };
 
@@ -81,7 +141,7 @@ namespace mehara::prapancha {
 
         void handle(auto &&ctx, auto &&sender) {
             Loggers::App().log_warn([&] { return std::format("{}. 501 NotImplemented!", controller_name); });
-            http::Response res{http::Status::NotImplemented};
+            http::Response res{http::Status::NotImplemented, ctx.request.arena};
             res.set_header("Content-Type", "text/html; charset=utf-8");
             res.body = "प्रपञ्च — Prapancha: 501 NotImplemented!";
             sender(std::move(res));
@@ -99,7 +159,7 @@ namespace mehara::prapancha {
 
         void handle(auto &&ctx, auto &&sender) {
             Loggers::App().log_warn([&] { return std::format("{}. 501 NotImplemented!", controller_name); });
-            http::Response res{http::Status::NotImplemented};
+            http::Response res{http::Status::NotImplemented, ctx.request.arena};
             res.set_header("Content-Type", "text/html; charset=utf-8");
             res.body = "प्रपञ्च — Prapancha: 501 NotImplemented!";
             sender(std::move(res));
@@ -117,7 +177,7 @@ namespace mehara::prapancha {
 
         void handle(auto &&ctx, auto &&sender) {
             Loggers::App().log_warn([&] { return std::format("{}. 501 NotImplemented!", controller_name); });
-            http::Response res{http::Status::NotImplemented};
+            http::Response res{http::Status::NotImplemented, ctx.request.arena};
             res.set_header("Content-Type", "text/html; charset=utf-8");
             res.body = "प्रपञ्च — Prapancha: 501 NotImplemented!";
             sender(std::move(res));
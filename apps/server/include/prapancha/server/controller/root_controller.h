@@ -14,7 +14,7 @@ namespace mehara::prapancha {
         using RequiredTraits = std::tuple<policy::WithRequest>;
 
         void handle(auto &&ctx, auto &&sender) {
-            http::Response res{http::Status::Ok};
+            http::Response res{http::Status::Ok, ctx.request.arena};
             res.set_header("Content-Type", "text/html; charset=utf-8");
             res.body = "प्रपञ्च — Prapancha!";
             sender(std::move(res));
@@ -17,7 +17,7 @@ namespace mehara::prapancha {
         void handle(auto &&ctx, auto &&sender) {
             Loggers::App().log_warn("प्रपञ्च — Prapancha: Void → [{} {}]", http::get_traits(ctx.request.method).name,
                                     ctx.request.target);
-            http::Response res{http::Status::NotFound};
+            http::Response res{http::Status::NotFound, ctx.request.arena};
             res.set_header("Content-Type", "text/html; charset=utf-8");
             res.body = "प्रपञ्च — Prapancha: शून्यम्। Nihil!";
             sender(std::move(res));
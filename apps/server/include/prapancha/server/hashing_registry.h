@@ -0,0 +1,103 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_HASHING_REGISTRY_H_
+#define PRAPANCHA_SERVER_HASHING_REGISTRY_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <expected>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+
+#include <prapancha/security/hashing_service.h>
+#include <prapancha/server/configuration.h>
+#include <prapancha/server/logger_registry.h>
+
+namespace mehara::prapancha {
+
+    struct HashingRegistry {
+        inline static std::unique_ptr<security::HashingService> service;
+        inline static std::optional<security::Argon2idCalibration> calibration; ///< Set if calibration ran.
+
+        /// Picks Argon2id costs for this host. Failure keeps the built-in costs.
+        static void calibrate(const configuration::Configuration::Hashing &hashing) {
+            const security::Argon2idTarget target{std::chrono::milliseconds(hashing.argon2_latency),
+                                                  hashing.argon2_max_memory * 1024};
+            auto result = security::Hasher::calibrate_argon2id(target);
+            if (!result) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: Argon2id calibration failed ({}); keeping defaults.",
+                                         result.error().code());
+                return;
+            }
+            const auto &[m, t, p] = result->parameters;
+            security::Hasher::set_argon2id_parameters(result->parameters);
+            Loggers::App().log_info("प्रपञ्च — Prapancha: Argon2id calibrated to m={} KiB t={} p={}: {} µs per hash "
+                                    "against {} ms ({} trials).",
+                                    m, t, p, result->latency.count() / 1000, hashing.argon2_latency, result->trials);
+            if (!result->met) {
+                Loggers::App().log_warn("प्रपञ्च — Prapancha: Argon2id cannot meet {} ms within the memory floor.",
+                                        hashing.argon2_latency);
+            }
+            calibration = *result;
+        }
+
+        /// Starts the hashing service and sizes OpenSSL's thread pool for multi-threaded Argon2id lanes. Failing to
+        /// size the pool only costs speed, so the service starts either way. Calibration, if asked for, runs with the
+        /// final thread settings so it measures what requests will see.
+        static void initialize(const configuration::Configuration::Hashing &hashing) {
+            const std::uint64_t max_threads = hashing.argon2_max_threads != 0
+                                                      ? hashing.argon2_max_threads
+                                                      : std::max(1U, std::thread::hardware_concurrency());
+            if (const auto threads = security::Hasher::set_argon2id_threads(hashing.argon2_threads, max_threads);
+                !threads) {
+                Loggers::App().log_warn("प्रपञ्च — Prapancha: Argon2id threads unavailable ({}); using one per hash.",
+                                        threads.error().code());
+                security::Hasher::set_argon2id_threads(1, 0);
+            } else {
+                Loggers::App().log_info("प्रपञ्च — Prapancha: Argon2id uses {} threads per hash, {} in total.",
+                                        hashing.argon2_threads, max_threads);
+            }
+            if (hashing.argon2_latency != 0) {
+                calibrate(hashing);
+            }
+            service = std::make_unique<security::HashingService>(security::HashingService::Options{
+                    hashing.workers, hashing.queue_capacity,
+                    static_cast<std::uint64_t>(hashing.memory_budget) * 1024 * 1024});
+        }
+    };
+
+    /// Hashes a password on the hashing service and completes on the caller's executor, e.g. with
+    /// boost::asio::use_awaitable from an awaitable handler. A saturated service completes with Error::Busy.
+    template<typename Token>
+    auto async_hash(std::string password, Token &&token) {
+        using Result = std::expected<security::Argon2idBinding, security::Error>;
+        return boost::asio::async_initiate<Token, void(Result)>(
+                [](auto handler, std::string password) {
+                    auto work = boost::asio::make_work_guard(handler);
+                    HashingRegistry::service->hash(
+                            std::move(password),
+                            [handler = std::move(handler), work = std::move(work)](Result result) mutable {
+                                const auto executor = work.get_executor();
+                                boost::asio::post(executor, [handler = std::move(handler), work = std::move(work),
+                                                             result = std::move(result)]() mutable {
+                                    std::move(handler)(std::move(result));
+                                });
+                            });
+                },
+                token, std::move(password));
+    }
+
+} // namespace mehara::prapancha
+
+#endif // PRAPANCHA_SERVER_HASHING_REGISTRY_H_
@@ -5,11 +5,28 @@
 #ifndef PRAPANCHA_SERVER_HTTP_H_
 #define PRAPANCHA_SERVER_HTTP_H_
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <variant>
 #include <vector>
 
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/fields.hpp>
+
+#include <prapancha/server/arena.h>
+#include <prapancha/server/codec/hex_codec.h>
+
 namespace mehara::prapancha::http {
 
     enum class Method { Delete, Get, Head, Options, Patch, Post, Put, Unknown };
@@ -49,22 +66,43 @@ namespace mehara::prapancha::http {
         Unauthorized = 401,
         Forbidden = 403,
         NotFound = 404,
+        MethodNotAllowed = 405,
         Conflict = 409,
+        PayloadTooLarge = 413,
         UnprocessableEntity = 422,
         InternalServerError = 500,
-        NotImplemented = 501
+        NotImplemented = 501,
+        ServiceUnavailable = 503
     };
 
+    /// @brief Allocator threaded through every per-request container so a connection's arena can back them.
+    using Allocator = std::pmr::polymorphic_allocator<>;
+
+    /// @brief Beast header fields allocated from the same arena as the request they belong to.
+    using Fields = boost::beast::http::basic_fields<std::pmr::polymorphic_allocator<char>>;
+
     struct Header {
-        std::string name;
-        std::string value;
+        using allocator_type = Allocator;
+
+        std::pmr::string name;
+        std::pmr::string value;
+
+        Header(const std::string_view header_name, const std::string_view header_value,
+               const allocator_type alloc = {}) : name(header_name, alloc), value(header_value, alloc) {}
+        Header(const Header &other, const allocator_type alloc) : name(other.name, alloc), value(other.value, alloc) {}
+        Header(Header &&other, const allocator_type alloc) :
+            name(std::move(other.name), alloc), value(std::move(other.value), alloc) {}
+        Header(const Header &) = default;
+        Header(Header &&) noexcept = default;
+        Header &operator=(const Header &) = default;
+        Header &operator=(Header &&) noexcept = default;
     };
 
     struct Request {
         Method method;
-        std::string target;
-        std::vector<Header> headers;
-        std::vector<uint8_t> body;
+        std::pmr::string target;
+        std::pmr::vector<Header> headers;
+        std::pmr::vector<uint8_t> body;
 
         [[nodiscard]] std::optional<std::string> header(std::string_view name) const {
             std::string combined;
@@ -81,12 +119,186 @@ namespace mehara::prapancha::http {
         }
     };
 
+    /// @brief Request body admission policy declared on a route.
+    ///
+    /// Requests whose Content-Length exceeds `bytes` are answered with 413 before any body byte is read; chunked
+    /// bodies are cut off at the same limit. Streaming routes receive the body through RequestView::stream instead of
+    /// RequestView::body and never hold more than one chunk of it.
+    struct BodyLimit {
+        static constexpr std::uint64_t Default = 1 << 20; ///< Matches Beast's default parser body limit.
+        static constexpr std::size_t ChunkSize = 16 * 1024; ///< Bytes delivered per streamed chunk at most.
+
+        std::uint64_t bytes = Default;
+        bool streaming = false;
+    };
+
+    /// @brief Incremental request body for routes declared with a streaming BodyLimit.
+    ///
+    /// The handler registers a sink before it returns. The transport then hands it each chunk as it arrives, on the
+    /// connection's executor, with `last` set on the final call. Chunks are only valid for the duration of the call.
+    /// Bytes that arrive while no sink is registered are discarded.
+    class BodyStream {
+    public:
+        using Sink = std::move_only_function<void(std::span<const std::uint8_t> chunk, bool last)>;
+
+        void read(Sink &&sink) { sink_ = std::move(sink); }
+
+        void deliver(const std::span<const std::uint8_t> chunk, const bool last) {
+            if (sink_) {
+                sink_(chunk, last);
+            }
+            if (last) {
+                sink_ = nullptr;
+            }
+        }
+
+    private:
+        Sink sink_;
+    };
+
+    /// @brief Values captured from the `{name}` and `*` segments of the route pattern a request matched.
+    ///
+    /// Values are views into RequestView::target, still percent-encoded, and names are views into the router's
+    /// static table, so capturing them allocates nothing.
+    struct PathParameters {
+        static constexpr std::size_t Capacity = 8; ///< Captures a single route may declare at most.
+        using Values = std::array<std::string_view, Capacity>;
+
+        std::span<const std::string_view> names;
+        Values values{};
+
+        [[nodiscard]] constexpr std::optional<std::string_view> find(const std::string_view name) const noexcept {
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                if (names[i] == name) {
+                    return values[i];
+                }
+            }
+            return std::nullopt;
+        }
+    };
+
+    /// @brief Non-owning view of a parsed request, borrowed from the transport's message.
+    ///
+    /// The view stays valid until the responder for its request is invoked. Handlers that keep the request beyond
+    /// that point take an owning copy with to_owned(). The arena backs everything the transport allocated for this
+    /// request and is reclaimed with it; responses built from it cost no global heap traffic. Every transport sets
+    /// it, and header() relies on it: nothing the view hands out is ever freed individually.
+    struct RequestView {
+        Method method = Method::Unknown;
+        std::string_view target;
+        std::span<const std::uint8_t> body;
+        const Fields *fields = nullptr;
+        Arena *arena = nullptr; ///< The request's own arena; required.
+        BodyStream *stream = nullptr; ///< Set only for streaming routes; `body` is then empty.
+        PathParameters parameters; ///< Filled in by the router before the handler runs.
+
+        [[nodiscard]] std::optional<std::string_view> param(const std::string_view name) const noexcept {
+            return parameters.find(name);
+        }
+
+        /// Decodes a captured segment with its hex codec, e.g. `param<UUID>("id")`; empty if it does not decode.
+        template<typename T>
+        [[nodiscard]] std::optional<T> param(const std::string_view name) const {
+            return parameters.find(name).and_then([](const std::string_view value) {
+                return codec::HexCodec<T>::decode(value);
+            });
+        }
+
+        /// Value of a header field. A field sent more than once is joined with ", " into the arena, as Request::header
+        /// does; a single field is returned as a view without copying. Lookup is Beast's ordered search by name,
+        /// O(log n) in the number of fields.
+        [[nodiscard]] std::optional<std::string_view> header(const boost::beast::http::field name) const {
+            return combine(fields->equal_range(name));
+        }
+
+        [[nodiscard]] std::optional<std::string_view> header(const std::string_view name) const {
+            return combine(fields->equal_range(name));
+        }
+
+        /// Copies the request out of the arena; the default allocator keeps it valid after the response is sent.
+        [[nodiscard]] Request to_owned(const Allocator alloc = {}) const {
+            Request request{method, std::pmr::string(target, alloc), std::pmr::vector<Header>(alloc),
+                            std::pmr::vector<uint8_t>(body.begin(), body.end(), alloc)};
+            for (const auto &field: *fields) {
+                request.headers.emplace_back(field.name_string(), field.value());
+            }
+            return request;
+        }
+
+    private:
+        template<typename Range>
+        [[nodiscard]] std::optional<std::string_view> combine(const Range &range) const {
+            auto [first, last] = range;
+            if (first == last) {
+                return std::nullopt;
+            }
+            if (std::next(first) == last) {
+                return first->value();
+            }
+            // Raw characters rather than a string object: the arena reclaims them at reset with nothing to destroy.
+            std::size_t length = 0;
+            for (auto field = first; field != last; ++field) {
+                length += (length == 0 ? 0 : 2) + field->value().size();
+            }
+            auto *combined = static_cast<char *>(arena->allocate(length, 1));
+            char *out = std::ranges::copy(first->value(), combined).out;
+            for (++first; first != last; ++first) {
+                out = std::ranges::copy(first->value(), std::ranges::copy(std::string_view(", "), out).out).out;
+            }
+            return std::string_view(combined, length);
+        }
+    };
+
+    /// @brief Immutable bytes shared by any number of in-flight responses without copying.
+    struct SharedBody {
+        std::shared_ptr<const std::string> bytes;
+
+        explicit SharedBody(std::shared_ptr<const std::string> shared_bytes) noexcept :
+            bytes(std::move(shared_bytes)) {}
+    };
+
+    /// @brief File region sent from the page cache with sendfile(2); it never passes through user space.
+    struct FileBody {
+        std::filesystem::path path;
+        std::uint64_t offset;
+        std::optional<std::uint64_t> length; ///< Bytes to send; std::nullopt sends through to the end of the file.
+
+        explicit FileBody(std::filesystem::path file_path, const std::uint64_t file_offset = 0,
+                          const std::optional<std::uint64_t> file_length = std::nullopt) :
+            path(std::move(file_path)), offset(file_offset), length(file_length) {}
+    };
+
+    /// @brief Body produced on demand and sent with chunked transfer encoding at constant memory.
+    ///
+    /// The generator fills the buffer it is handed and returns the number of bytes written; zero ends the body.
+    struct StreamBody {
+        using Generator = std::move_only_function<std::size_t(std::span<char>)>;
+        static constexpr std::size_t DefaultChunkSize = 16 * 1024;
+
+        Generator generator;
+        std::size_t chunk_size;
+
+        explicit StreamBody(Generator body_generator, const std::size_t body_chunk_size = DefaultChunkSize) :
+            generator(std::move(body_generator)), chunk_size(body_chunk_size) {}
+    };
+
     struct Response {
+        using allocator_type = Allocator;
+        using Body = std::variant<std::pmr::string, SharedBody, FileBody, StreamBody>;
+
         Status status = Status::Ok;
-        std::vector<Header> headers;
-        std::string body; // Using string for text-based responses
+        std::pmr::vector<Header> headers;
+        Body body;
 
-        void set_header(std::string name, std::string value) { headers.push_back({std::move(name), std::move(value)}); }
+        explicit Response(const Status response_status = Status::Ok, const allocator_type alloc = {}) :
+            status(response_status), headers(alloc), body(std::in_place_type<std::pmr::string>, alloc) {}
+
+        Response(const Status response_status, const std::string_view text, const allocator_type alloc = {}) :
+            status(response_status), headers(alloc), body(std::in_place_type<std::pmr::string>, text, alloc) {}
+
+        void set_header(const std::string_view name, const std::string_view value) {
+            headers.emplace_back(name, value);
+        }
     };
 
 } // namespace mehara::prapancha::http
@@ -0,0 +1,626 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_HTTP2_SESSION_H_
+#define PRAPANCHA_SERVER_HTTP2_SESSION_H_
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <nghttp2/nghttp2.h>
+
+#include <prapancha/server/arena.h>
+#include <prapancha/server/beast_adapter.h>
+#include <prapancha/server/codec/base64url_codec.h>
+#include <prapancha/server/configuration.h>
+#include <prapancha/server/http.h>
+#include <prapancha/server/incoming.h>
+#include <prapancha/server/logger_registry.h>
+#include <prapancha/server/responder.h>
+#include <prapancha/server/tls.h>
+
+namespace mehara::prapancha {
+
+    /// @brief HTTP/2 cleartext (h2c) connection multiplexing many requests onto one socket.
+    ///
+    /// Framing, HPACK and flow control are delegated to nghttp2 in its non-blocking memory mode: bytes read from the
+    /// socket are fed to nghttp2_session_mem_recv2() and whatever nghttp2_session_mem_send2() produces is written back
+    /// in batches. Each stream maps onto the same http::RequestView / Router::dispatch pipeline as Session, with its
+    /// own Arena, and responses may complete in any order. Connections arrive either with the client preface (prior
+    /// knowledge), through an HTTP/1.1 `Upgrade: h2c` request handed over by Session, or over TLS once ALPN has
+    /// selected h2.
+    ///
+    /// Each stream's BodyLimit is looked up once its HEADERS frame is complete. An oversized content-length or body
+    /// is answered with 413 on that stream alone, and streaming routes are dispatched right away and fed DATA frames
+    /// as nghttp2 delivers them.
+    template<typename Router, typename Transport = boost::beast::tcp_stream>
+    class Http2Session : public std::enable_shared_from_this<Http2Session<Router, Transport>> {
+    public:
+        static constexpr std::string_view client_preface{NGHTTP2_CLIENT_MAGIC, NGHTTP2_CLIENT_MAGIC_LEN};
+
+    private:
+        static constexpr std::size_t read_chunk_size = 16 * 1024;
+        static constexpr std::size_t write_batch_size = 64 * 1024;
+
+        struct Stream {
+            // Declared first so it is destroyed last; the exchange below is allocated from it.
+            Arena arena{configuration::Active->network.arena_size};
+            std::int32_t id = 0;
+            http::Method method = http::Method::Unknown;
+            http::BodyLimit limit;
+            http::BodyStream body_stream;
+            std::uint64_t received = 0;
+            bool pending = false;
+            bool closed = false;
+            bool rejected = false; ///< Answered without its body; further DATA is dropped.
+
+            struct Exchange {
+                std::pmr::string target;
+                http::Fields fields;
+                std::pmr::vector<std::uint8_t> body;
+                std::optional<http::Response> response;
+                boost::beast::file file;
+                std::uint64_t offset = 0;
+                std::uint64_t remaining = 0;
+
+                explicit Exchange(Arena &arena) :
+                    target(&arena), fields(std::pmr::polymorphic_allocator<char>(&arena)), body(&arena) {}
+            };
+            std::optional<Exchange> exchange;
+
+            void open(const std::int32_t stream_id) {
+                id = stream_id;
+                exchange.emplace(arena);
+            }
+
+            void reset() {
+                exchange.reset();
+                body_stream = {};
+                arena.reset();
+                method = http::Method::Unknown;
+                limit = {};
+                received = 0;
+                pending = false;
+                closed = false;
+                rejected = false;
+            }
+        };
+
+        Transport stream_;
+        boost::beast::flat_buffer buffer_;
+        std::unique_ptr<nghttp2_session, decltype(&nghttp2_session_del)> session_{nullptr, nghttp2_session_del};
+        std::unordered_map<std::int32_t, std::unique_ptr<Stream>> streams_;
+        std::vector<std::unique_ptr<Stream>> spare_;
+        std::vector<std::uint8_t> outgoing_;
+        bool reading_ = false;
+        bool writing_ = false;
+        bool receiving_ = false;
+
+    public:
+        Http2Session(Transport &&stream, boost::beast::flat_buffer &&buffer) :
+            stream_(std::move(stream)), buffer_(std::move(buffer)) {
+            nghttp2_session_callbacks *callbacks = nullptr;
+            nghttp2_session_callbacks_new(&callbacks);
+            nghttp2_session_callbacks_set_on_begin_headers_callback(callbacks, &Http2Session::on_begin_headers);
+            nghttp2_session_callbacks_set_on_header_callback(callbacks, &Http2Session::on_header);
+            nghttp2_session_callbacks_set_on_data_chunk_recv_callback(callbacks, &Http2Session::on_data_chunk);
+            nghttp2_session_callbacks_set_on_frame_recv_callback(callbacks, &Http2Session::on_frame);
+            nghttp2_session_callbacks_set_on_stream_close_callback(callbacks, &Http2Session::on_stream_close);
+            nghttp2_session *session = nullptr;
+            nghttp2_session_server_new(&session, callbacks, this);
+            nghttp2_session_callbacks_del(callbacks);
+            session_.reset(session);
+            outgoing_.reserve(write_batch_size);
+        }
+
+        Http2Session(const Http2Session &) = delete;
+        Http2Session &operator=(const Http2Session &) = delete;
+
+        /// Starts a connection that opened with the client preface, or negotiated h2 through ALPN. The preface is read
+        /// from the handed-over buffer first.
+        void run() {
+            if (!submit_settings() || !receive()) {
+                return;
+            }
+            do_write();
+            do_read();
+        }
+
+        /// Continues a connection upgraded from HTTP/1.1. The upgrade request becomes stream 1 and is answered over
+        /// HTTP/2 once the client preface arrives.
+        void upgrade(http::Request &&request, const std::string_view settings) {
+            // HTTP2-Settings is base64url without padding.
+            const auto payload = codec::Base64UrlCodec<std::vector<std::uint8_t>>::decode(settings);
+            if (!payload) {
+                Loggers::App().log_warn("प्रपञ्च — Prapancha: h2c upgrade rejected: malformed HTTP2-Settings.");
+                return do_close();
+            }
+            if (const int rv = nghttp2_session_upgrade2(session_.get(), payload->data(), payload->size(),
+                                                        request.method == http::Method::Head, nullptr);
+                rv != 0) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: h2c upgrade rejected [{}]: {}", rv,
+                                         nghttp2_strerror(rv));
+                return do_close();
+            }
+            auto &stream = open(1);
+            auto &exchange = *stream.exchange;
+            stream.method = request.method;
+            exchange.target = request.target;
+            for (const auto &header: request.headers) {
+                exchange.fields.insert(header.name, header.value);
+            }
+            exchange.body.assign(request.body.begin(), request.body.end());
+            if (!submit_settings()) {
+                return;
+            }
+            dispatch(stream);
+            if (!receive()) {
+                return;
+            }
+            do_write();
+            do_read();
+        }
+
+    private:
+        [[nodiscard]] static Http2Session &from(void *user_data) noexcept {
+            return *static_cast<Http2Session *>(user_data);
+        }
+
+        [[nodiscard]] Stream *find(const std::int32_t stream_id) noexcept {
+            const auto it = streams_.find(stream_id);
+            return it != streams_.end() ? it->second.get() : nullptr;
+        }
+
+        Stream &open(const std::int32_t stream_id) {
+            std::unique_ptr<Stream> stream;
+            if (spare_.empty()) {
+                stream = std::make_unique<Stream>();
+            } else {
+                stream = std::move(spare_.back());
+                spare_.pop_back();
+            }
+            stream->open(stream_id);
+            return *streams_.insert_or_assign(stream_id, std::move(stream)).first->second;
+        }
+
+        /// Returns a finished stream's storage, arena included, to the pool for the next stream.
+        void recycle(const std::int32_t stream_id) {
+            const auto it = streams_.find(stream_id);
+            if (it == streams_.end()) {
+                return;
+            }
+            it->second->reset();
+            spare_.push_back(std::move(it->second));
+            streams_.erase(it);
+        }
+
+        bool submit_settings() {
+            const nghttp2_settings_entry settings[] = {
+                    {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, configuration::Active->network.max_concurrent_streams},
+            };
+            if (const int rv =
+                        nghttp2_submit_settings(session_.get(), NGHTTP2_FLAG_NONE, settings, std::size(settings));
+                rv != 0) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: HTTP/2 settings failed [{}]: {}", rv,
+                                         nghttp2_strerror(rv));
+                do_close();
+                return false;
+            }
+            return true;
+        }
+
+        void do_read() {
+            if (reading_) {
+                return;
+            }
+            if (nghttp2_session_want_read(session_.get()) == 0) {
+                if (!writing_ && nghttp2_session_want_write(session_.get()) == 0) {
+                    do_close();
+                }
+                return;
+            }
+            reading_ = true;
+            // Idle connections time out; a connection with streams in flight waits for its handlers.
+            if (streams_.empty()) {
+                stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            } else {
+                stream_.expires_never();
+            }
+            stream_.async_read_some(buffer_.prepare(read_chunk_size),
+                                    boost::beast::bind_front_handler(&Http2Session::on_read, this->shared_from_this()));
+        }
+
+        void on_read(boost::beast::error_code ec, const std::size_t bytes_transferred) {
+            reading_ = false;
+            if (ec) {
+                return;
+            }
+            buffer_.commit(bytes_transferred);
+            if (!receive()) {
+                return;
+            }
+            do_write();
+            do_read();
+        }
+
+        /// Feeds buffered bytes to nghttp2, which invokes the frame callbacks below. Returns false on a fatal error.
+        bool receive() {
+            if (buffer_.size() == 0) {
+                return true;
+            }
+            const auto data = buffer_.data();
+            receiving_ = true;
+            const nghttp2_ssize rv = nghttp2_session_mem_recv2(
+                    session_.get(), static_cast<const std::uint8_t *>(data.data()), data.size());
+            receiving_ = false;
+            buffer_.consume(buffer_.size());
+            if (rv < 0) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: HTTP/2 receive failed [{}]: {}", rv,
+                                         nghttp2_strerror(static_cast<int>(rv)));
+                do_close();
+                return false;
+            }
+            return true;
+        }
+
+        void do_write() {
+            // nghttp2 must not be re-entered from its own callbacks; receive() is always followed by do_write().
+            if (writing_ || receiving_) {
+                return;
+            }
+            outgoing_.clear();
+            while (outgoing_.size() < write_batch_size) {
+                const std::uint8_t *data = nullptr;
+                const nghttp2_ssize produced = nghttp2_session_mem_send2(session_.get(), &data);
+                if (produced < 0) {
+                    Loggers::App().log_error("प्रपञ्च — Prapancha: HTTP/2 send failed [{}]: {}", produced,
+                                             nghttp2_strerror(static_cast<int>(produced)));
+                    return do_close();
+                }
+                if (produced == 0) {
+                    break;
+                }
+                outgoing_.insert(outgoing_.end(), data, data + produced);
+            }
+            if (outgoing_.empty()) {
+                if (!reading_ && nghttp2_session_want_read(session_.get()) == 0 &&
+                    nghttp2_session_want_write(session_.get()) == 0) {
+                    do_close();
+                }
+                return;
+            }
+            writing_ = true;
+            boost::asio::async_write(stream_, boost::asio::buffer(outgoing_),
+                                     boost::beast::bind_front_handler(&Http2Session::on_write,
+                                                                      this->shared_from_this()));
+        }
+
+        void on_write(boost::beast::error_code ec, std::size_t) {
+            writing_ = false;
+            if (ec) {
+                return;
+            }
+            do_write();
+            do_read();
+        }
+
+        /// Applies the route's body policy to a stream whose request header block has just completed.
+        void admit(Stream &stream) {
+            auto &exchange = *stream.exchange;
+            stream.limit = Router::body_limit(stream.method, exchange.target);
+            const auto it = exchange.fields.find(boost::beast::http::field::content_length);
+            if (it == exchange.fields.end()) {
+                return;
+            }
+            const std::string_view value = it->value();
+            std::uint64_t length = 0;
+            if (const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), length);
+                ec == std::errc{} && length > stream.limit.bytes) {
+                reject(stream);
+            }
+        }
+
+        /// Answers 413 to a stream whose body was refused, or 404/405 when no route would have taken it. Later DATA
+        /// frames on a rejected stream are dropped.
+        void reject(Stream &stream) {
+            stream.rejected = true;
+            stream.body_stream = {};
+            if (stream.pending) {
+                // A streaming handler already owns the response; all that is left is to stop the upload.
+                nghttp2_submit_rst_stream(session_.get(), NGHTTP2_FLAG_NONE, stream.id, NGHTTP2_CANCEL);
+                return;
+            }
+            if (!Router::routed(stream.method, stream.exchange->target)) {
+                return dispatch(stream);
+            }
+            submit(stream, incoming::too_large(&stream.arena));
+        }
+
+        void dispatch(Stream &stream) {
+            stream.pending = true;
+            auto &exchange = *stream.exchange;
+            // The view borrows from the stream's exchange, which is only recycled once its response has been sent.
+            http::RequestView request{stream.method, exchange.target, exchange.body, &exchange.fields, &stream.arena};
+            if (stream.limit.streaming) {
+                request.stream = &stream.body_stream;
+            }
+            http::Responder send = [self = this->shared_from_this(), stream_id = stream.id](http::Response &&response) {
+                self->on_response(stream_id, std::move(response));
+            };
+            Router::dispatch(std::move(request), std::move(send));
+        }
+
+        void on_response(const std::int32_t stream_id, http::Response &&response) {
+            // Handlers may complete on any thread; hop back onto the connection's executor before touching nghttp2.
+            boost::asio::dispatch(stream_.get_executor(), [self = this->shared_from_this(), stream_id,
+                                                           response = std::move(response)]() mutable {
+                auto *stream = self->find(stream_id);
+                if (!stream) {
+                    return;
+                }
+                stream->pending = false;
+                if (stream->closed) {
+                    return self->recycle(stream_id);
+                }
+                self->submit(*stream, std::move(response));
+                self->do_write();
+            });
+        }
+
+        void submit(Stream &stream, http::Response &&response) {
+            auto &exchange = *stream.exchange;
+            auto &res = exchange.response.emplace(std::move(response));
+            bool chunked = false;
+            bool missing = false;
+            std::visit(
+                    [&]<typename Body>(Body &body) {
+                        if constexpr (std::same_as<Body, http::FileBody>) {
+                            boost::beast::error_code ec;
+                            exchange.file.open(body.path.c_str(), boost::beast::file_mode::scan, ec);
+                            const std::uint64_t size = ec ? 0 : exchange.file.size(ec);
+                            if (ec || body.offset > size) {
+                                Loggers::App().log_error("प्रपञ्च — Prapancha: Unable to serve {} [{}]: {}",
+                                                         body.path.string(), ec.value(), ec.message());
+                                missing = true;
+                                return;
+                            }
+                            exchange.offset = body.offset;
+                            exchange.remaining =
+                                    std::min(body.length.value_or(size - body.offset), size - body.offset);
+                        } else if constexpr (std::same_as<Body, http::StreamBody>) {
+                            chunked = true;
+                        } else if constexpr (std::same_as<Body, http::SharedBody>) {
+                            exchange.remaining = body.bytes->size();
+                        } else {
+                            exchange.remaining = body.size();
+                        }
+                    },
+                    res.body);
+            if (missing) {
+                res = http::Response{http::Status::NotFound, "प्रपञ्च — Prapancha: शून्यम्। Nihil!", &stream.arena};
+                res.set_header("Content-Type", "text/html; charset=utf-8");
+                exchange.remaining = std::get<std::pmr::string>(res.body).size();
+            }
+            const std::pmr::string status(std::to_string(static_cast<int>(res.status)), &stream.arena);
+            const std::pmr::string length(std::to_string(exchange.remaining), &stream.arena);
+            std::pmr::vector<nghttp2_nv> nva(&stream.arena);
+            nva.reserve(res.headers.size() + 2);
+            nva.push_back(make_nv(":status", status));
+            for (auto &header: res.headers) {
+                // HTTP/2 field names are lowercase and connection-specific fields are forbidden.
+                std::ranges::transform(header.name, header.name.begin(), [](const unsigned char c) {
+                    return static_cast<char>(std::tolower(c));
+                });
+                if (is_connection_specific(header.name) || header.name == "content-length") {
+                    continue;
+                }
+                nva.push_back(make_nv(header.name, header.value));
+            }
+            if (!chunked) {
+                nva.push_back(make_nv("content-length", length));
+            }
+            const bool has_body = stream.method != http::Method::Head && (chunked || exchange.remaining > 0);
+            nghttp2_data_provider2 provider{};
+            provider.source.ptr = &stream;
+            provider.read_callback = &Http2Session::read_body;
+            if (const int rv = nghttp2_submit_response2(session_.get(), stream.id, nva.data(), nva.size(),
+                                                        has_body ? &provider : nullptr);
+                rv != 0) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: HTTP/2 response failed [{}]: {}", rv,
+                                         nghttp2_strerror(rv));
+                nghttp2_submit_rst_stream(session_.get(), NGHTTP2_FLAG_NONE, stream.id, NGHTTP2_INTERNAL_ERROR);
+            }
+        }
+
+        [[nodiscard]] static bool is_connection_specific(const std::string_view name) noexcept {
+            return name == "connection" || name == "keep-alive" || name == "proxy-connection" ||
+                   name == "transfer-encoding" || name == "upgrade";
+        }
+
+        [[nodiscard]] static nghttp2_nv make_nv(const std::string_view name, const std::string_view value) noexcept {
+            return {reinterpret_cast<std::uint8_t *>(const_cast<char *>(name.data())),
+                    reinterpret_cast<std::uint8_t *>(const_cast<char *>(value.data())), name.size(), value.size(),
+                    NGHTTP2_NV_FLAG_NONE};
+        }
+
+        /// Fills one DATA frame straight from the response body; nghttp2 paces calls to the peer's flow-control window.
+        static nghttp2_ssize read_body(nghttp2_session *, std::int32_t, std::uint8_t *buf, const std::size_t length,
+                                       std::uint32_t *data_flags, nghttp2_data_source *source, void *) {
+            auto &exchange = *static_cast<Stream *>(source->ptr)->exchange;
+            nghttp2_ssize produced = 0;
+            std::visit(
+                    [&]<typename Body>(Body &body) {
+                        if constexpr (std::same_as<Body, http::StreamBody>) {
+                            produced = static_cast<nghttp2_ssize>(
+                                    body.generator({reinterpret_cast<char *>(buf), length}));
+                            if (produced == 0) {
+                                *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+                            }
+                            return;
+                        } else if constexpr (std::same_as<Body, http::FileBody>) {
+                            const std::size_t wanted = std::min<std::uint64_t>(length, exchange.remaining);
+                            ssize_t read = 0;
+                            do {
+                                read = ::pread(exchange.file.native_handle(), buf, wanted,
+                                               static_cast<off_t>(exchange.offset));
+                            } while (read < 0 && errno == EINTR);
+                            if (read <= 0) {
+                                // A short file leaves the advertised content-length unmet; reset just this stream.
+                                produced = NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+                                return;
+                            }
+                            produced = read;
+                        } else {
+                            const std::string_view view = [&] {
+                                if constexpr (std::same_as<Body, http::SharedBody>) {
+                                    return std::string_view(*body.bytes);
+                                } else {
+                                    return std::string_view(body);
+                                }
+                            }();
+                            const std::size_t wanted = std::min<std::uint64_t>(length, exchange.remaining);
+                            std::memcpy(buf, view.data() + (view.size() - exchange.remaining), wanted);
+                            produced = static_cast<nghttp2_ssize>(wanted);
+                        }
+                        exchange.offset += static_cast<std::uint64_t>(produced);
+                        exchange.remaining -= static_cast<std::uint64_t>(produced);
+                        if (exchange.remaining == 0) {
+                            *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+                        }
+                    },
+                    exchange.response->body);
+            return produced;
+        }
+
+        static int on_begin_headers(nghttp2_session *, const nghttp2_frame *frame, void *user_data) {
+            if (frame->hd.type == NGHTTP2_HEADERS && frame->headers.cat == NGHTTP2_HCAT_REQUEST) {
+                from(user_data).open(frame->hd.stream_id);
+            }
+            return 0;
+        }
+
+        static int on_header(nghttp2_session *, const nghttp2_frame *frame, const std::uint8_t *name,
+                             const std::size_t name_length, const std::uint8_t *value, const std::size_t value_length,
+                             std::uint8_t, void *user_data) {
+            auto *stream = from(user_data).find(frame->hd.stream_id);
+            if (!stream || stream->pending) {
+                return 0;
+            }
+            auto &exchange = *stream->exchange;
+            const std::string_view field_name(reinterpret_cast<const char *>(name), name_length);
+            const std::string_view field_value(reinterpret_cast<const char *>(value), value_length);
+            if (field_name == ":method") {
+                stream->method = http::from_beast(boost::beast::http::string_to_verb(field_value));
+            } else if (field_name == ":path") {
+                exchange.target = field_value;
+            } else if (field_name == ":authority") {
+                exchange.fields.set(boost::beast::http::field::host, field_value);
+            } else if (!field_name.starts_with(':')) {
+                exchange.fields.insert(field_name, field_value);
+            }
+            return 0;
+        }
+
+        static int on_data_chunk(nghttp2_session *, std::uint8_t, const std::int32_t stream_id,
+                                 const std::uint8_t *data, const std::size_t length, void *user_data) {
+            auto &self = from(user_data);
+            auto *stream = self.find(stream_id);
+            if (!stream || stream->closed || stream->rejected) {
+                return 0;
+            }
+            stream->received += length;
+            if (stream->received > stream->limit.bytes) {
+                self.reject(*stream);
+                return 0;
+            }
+            if (stream->limit.streaming) {
+                stream->body_stream.deliver({data, length}, false);
+                return 0;
+            }
+            auto &body = stream->exchange->body;
+            body.insert(body.end(), data, data + length);
+            return 0;
+        }
+
+        static int on_frame(nghttp2_session *, const nghttp2_frame *frame, void *user_data) {
+            if (frame->hd.type != NGHTTP2_HEADERS && frame->hd.type != NGHTTP2_DATA) {
+                return 0;
+            }
+            auto &self = from(user_data);
+            auto *stream = self.find(frame->hd.stream_id);
+            if (!stream || stream->closed || stream->rejected) {
+                return 0;
+            }
+            if (frame->hd.type == NGHTTP2_HEADERS && frame->headers.cat == NGHTTP2_HCAT_REQUEST) {
+                self.admit(*stream);
+                if (stream->rejected) {
+                    return 0;
+                }
+                if (stream->limit.streaming) {
+                    self.dispatch(*stream);
+                }
+            }
+            if ((frame->hd.flags & NGHTTP2_FLAG_END_STREAM) == 0) {
+                return 0;
+            }
+            if (stream->limit.streaming) {
+                stream->body_stream.deliver({}, true);
+            } else if (!stream->pending) {
+                self.dispatch(*stream);
+            }
+            return 0;
+        }
+
+        static int on_stream_close(nghttp2_session *, const std::int32_t stream_id, std::uint32_t, void *user_data) {
+            auto &self = from(user_data);
+            auto *stream = self.find(stream_id);
+            if (!stream) {
+                return 0;
+            }
+            // A handler still holds a view into this stream; release it when its response arrives. A body that will
+            // never finish is cut off here so the sink does not outlive the stream.
+            if (stream->pending) {
+                stream->closed = true;
+                stream->body_stream = {};
+                return 0;
+            }
+            self.recycle(stream_id);
+            return 0;
+        }
+
+        void do_close() {
+            if constexpr (std::same_as<Transport, tls::Stream>) {
+                stream_.close_notify();
+            }
+            boost::system::error_code ignored_ec;
+            stream_.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_send, ignored_ec);
+        }
+    };
+
+} // namespace mehara::prapancha
+
+#endif // PRAPANCHA_SERVER_HTTP2_SESSION_H_
@@ -0,0 +1,50 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_INCOMING_H_
+#define PRAPANCHA_SERVER_INCOMING_H_
+
+#include <memory_resource>
+#include <string_view>
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <prapancha/server/beast_adapter.h>
+#include <prapancha/server/http.h>
+
+/// @brief Admission of HTTP/1.1 request bodies, shared by every transport that reads them.
+namespace mehara::prapancha::incoming {
+
+    /// What to do with a request whose header has been parsed but whose body has not been read.
+    enum class Admission {
+        Accept, ///< Read the body.
+        Continue, ///< Send 100 Continue, then read the body.
+        Reject ///< Answer 413 without reading the body; the connection cannot be reused.
+    };
+
+    inline constexpr std::string_view continue_response = "HTTP/1.1 100 Continue\r\n\r\n";
+
+    /// Checks a parsed header against the route's limit and applies the limit to the rest of the parse.
+    template<typename Parser>
+    [[nodiscard]] Admission admit(Parser &parser, const http::BodyLimit limit) {
+        if (const auto length = parser.content_length(); length && *length > limit.bytes) {
+            return Admission::Reject;
+        }
+        parser.body_limit(limit.bytes);
+        if (boost::beast::iequals(parser.get()[boost::beast::http::field::expect], "100-continue")) {
+            return Admission::Continue;
+        }
+        return Admission::Accept;
+    }
+
+    [[nodiscard]] inline http::Response too_large(std::pmr::memory_resource *arena) {
+        http::Response response{http::Status::PayloadTooLarge, "प्रपञ्च — Prapancha: अतिभारः। Nimis!", arena};
+        response.set_header("Content-Type", "text/html; charset=utf-8");
+        return response;
+    }
+
+} // namespace mehara::prapancha::incoming
+
+#endif // PRAPANCHA_SERVER_INCOMING_H_
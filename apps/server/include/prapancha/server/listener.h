@@ -5,38 +5,90 @@
 #ifndef PRAPANCHA_SERVER_LISTENER_H_
 #define PRAPANCHA_SERVER_LISTENER_H_
 
+#include <cerrno>
+#include <cstring>
 #include <memory>
 
+#include <sys/socket.h>
+
+#include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
 
+#include <prapancha/server/configuration.h>
 #include <prapancha/server/session.h>
+#include <prapancha/server/tls.h>
 
 namespace mehara::prapancha {
 
     template<typename Router>
     class Listener : public std::enable_shared_from_this<Listener<Router>> {
+        using Execution = configuration::Configuration::Network::Execution;
+
         boost::asio::io_context &ioc_;
+        Execution execution_;
+        const tls::Context *tls_;
         boost::asio::ip::tcp::acceptor acceptor_;
+        bool listening_ = false;
 
     public:
-        Listener(boost::asio::io_context &ioc, const boost::asio::ip::tcp::endpoint &endpoint) :
-            ioc_(ioc), acceptor_(boost::asio::make_strand(ioc)) {
+        /// Connections are terminated with TLS when a context is given; it must outlive the listener.
+        Listener(boost::asio::io_context &ioc, const boost::asio::ip::tcp::endpoint &endpoint,
+                 const Execution execution = Execution::Shared, const tls::Context *tls = nullptr) :
+            ioc_(ioc), execution_(execution), tls_(tls), acceptor_(connection_executor()) {
             boost::beast::error_code ec;
-            acceptor_.open(endpoint.protocol(), ec);
-            acceptor_.set_option(boost::asio::socket_base::reuse_address(true), ec);
-            acceptor_.bind(endpoint, ec);
-            acceptor_.listen(boost::asio::socket_base::max_listen_connections, ec);
+            if (acceptor_.open(endpoint.protocol(), ec); ec) {
+                fail("open", ec);
+                return;
+            }
+            if (acceptor_.set_option(boost::asio::socket_base::reuse_address(true), ec); ec) {
+                fail("SO_REUSEADDR", ec);
+                return;
+            }
+            if (execution_ == Execution::Sharded) {
+                // Every shard binds its own acceptor to the same endpoint; the kernel balances connections across them.
+                constexpr int enabled = 1;
+                if (::setsockopt(acceptor_.native_handle(), SOL_SOCKET, SO_REUSEPORT, &enabled, sizeof(enabled)) < 0) {
+                    Loggers::App().log_error("प्रपञ्च — Prapancha: SO_REUSEPORT unavailable [{}]: {}", errno,
+                                             std::strerror(errno));
+                }
+            }
+            if (acceptor_.bind(endpoint, ec); ec) {
+                fail("bind", ec);
+                return;
+            }
+            if (acceptor_.listen(boost::asio::socket_base::max_listen_connections, ec); ec) {
+                fail("listen", ec);
+                return;
+            }
+            listening_ = true;
         }
 
+        /// False when the endpoint could not be bound or listened on; the reason has been logged.
+        [[nodiscard]] bool ready() const noexcept { return listening_; }
+
         void run() { do_accept(); }
 
     private:
+        void fail(const char *step, const boost::beast::error_code &ec) {
+            Loggers::App().log_error("प्रपञ्च — Prapancha: Listener {} failed [{}]: {}", step, ec.value(), ec.message());
+            boost::beast::error_code ignored;
+            acceptor_.close(ignored);
+        }
+
+        /// Shared execution serializes each connection on a strand of the common io_context. A shard's io_context is
+        /// driven by exactly one thread, which already serializes its handlers.
+        [[nodiscard]] boost::asio::any_io_executor connection_executor() const {
+            if (execution_ == Execution::Sharded) {
+                return ioc_.get_executor();
+            }
+            return boost::asio::make_strand(ioc_);
+        }
+
         void do_accept() {
-            acceptor_.async_accept(boost::asio::make_strand(ioc_), [self = this->shared_from_this()](
-                                                                           auto ec,
-                                                                           boost::asio::ip::tcp::socket socket) {
+            acceptor_.async_accept(connection_executor(), [self = this->shared_from_this()](
+                                                                  auto ec, boost::asio::ip::tcp::socket socket) {
                 if (!ec) {
                     boost::beast::error_code endpoint_ec;
                     const auto remote = socket.remote_endpoint(endpoint_ec);
@@ -46,7 +98,12 @@ namespace mehara::prapancha {
                         Loggers::App().log_warn("प्रपञ्च — Prapancha: Connection accepted but endpoint unreachable: {}",
                                                 endpoint_ec.message());
                     }
-                    std::make_shared<Session<Router>>(std::move(socket))->run();
+                    if (self->tls_) {
+                        std::make_shared<Session<Router, tls::Stream>>(tls::Stream(std::move(socket), *self->tls_))
+                                ->run();
+                    } else {
+                        std::make_shared<Session<Router>>(boost::beast::tcp_stream(std::move(socket)))->run();
+                    }
                 } else if (ec != boost::asio::error::operation_aborted) {
                     Loggers::App().log_error("प्रपञ्च — Prapancha: Accept failed [{}]: {}", ec.value(), ec.message());
                 }
@@ -0,0 +1,133 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_OUTGOING_H_
+#define PRAPANCHA_SERVER_OUTGOING_H_
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <prapancha/server/arena.h>
+#include <prapancha/server/beast_adapter.h>
+#include <prapancha/server/http.h>
+#include <prapancha/server/logger_registry.h>
+
+/// @brief Serialization state for one HTTP/1.1 response, shared by every transport that writes them.
+namespace mehara::prapancha::outgoing {
+
+    using Fields = http::Fields;
+    using SizedBody = boost::beast::http::span_body<const char>;
+    using HeaderOnlyBody = boost::beast::http::empty_body;
+    using ChunkedBody = boost::beast::http::buffer_body;
+
+    /// In-memory body serialized straight from the buffer the handler produced.
+    struct Sized {
+        std::variant<std::pmr::string, http::SharedBody> bytes;
+        boost::beast::http::response<SizedBody, Fields> message;
+        boost::beast::http::response_serializer<SizedBody, Fields> serializer;
+
+        template<typename Bytes>
+        Sized(boost::beast::http::response_header<Fields> &&header, Bytes &&body) :
+            bytes(std::forward<Bytes>(body)), message(std::move(header)), serializer(message) {
+            const std::string_view view = std::holds_alternative<std::pmr::string>(bytes)
+                                                  ? std::string_view(std::get<std::pmr::string>(bytes))
+                                                  : std::string_view(*std::get<http::SharedBody>(bytes).bytes);
+            message.body() = {view.data(), view.size()};
+            message.prepare_payload();
+        }
+
+        Sized(const Sized &) = delete;
+        Sized &operator=(const Sized &) = delete;
+    };
+
+    /// File region; the serializer only emits the header and the transport moves the bytes itself.
+    struct File {
+        boost::beast::file file;
+        std::uint64_t offset = 0;
+        std::uint64_t remaining = 0;
+        boost::beast::http::response<HeaderOnlyBody, Fields> message;
+        boost::beast::http::response_serializer<HeaderOnlyBody, Fields> serializer;
+
+        explicit File(boost::beast::http::response_header<Fields> &&header) :
+            message(std::move(header)), serializer(message) {}
+
+        File(const File &) = delete;
+        File &operator=(const File &) = delete;
+    };
+
+    /// Chunked body pulled from its generator into a single arena-allocated buffer.
+    struct Stream {
+        http::StreamBody source;
+        char *chunk;
+        boost::beast::http::response<ChunkedBody, Fields> message;
+        boost::beast::http::response_serializer<ChunkedBody, Fields> serializer;
+
+        Stream(boost::beast::http::response_header<Fields> &&header, http::StreamBody &&body, Arena &arena) :
+            source(std::move(body)), chunk(static_cast<char *>(arena.allocate(source.chunk_size, 1))),
+            message(std::move(header)), serializer(message) {
+            message.chunked(true);
+            message.body().data = nullptr;
+            message.body().more = true;
+        }
+
+        Stream(const Stream &) = delete;
+        Stream &operator=(const Stream &) = delete;
+
+        /// Refills the chunk from the generator; an empty chunk ends the body.
+        void next_chunk() {
+            auto &body = message.body();
+            const std::size_t produced = source.generator({chunk, source.chunk_size});
+            body.data = produced > 0 ? chunk : nullptr;
+            body.size = produced;
+            body.more = produced > 0;
+        }
+    };
+
+    using Message = std::variant<std::monostate, Sized, File, Stream>;
+
+    /// Builds the serialization state for a handler's response in the request's arena. A file that cannot be opened
+    /// is answered with 404 instead.
+    inline void prepare(Message &outgoing, Arena &arena, http::Response &&response, const bool keep_alive) {
+        auto header = http::to_beast(response.status, response.headers, &arena);
+        header.keep_alive(keep_alive);
+        std::visit(
+                [&]<typename Body>(Body &&body) {
+                    if constexpr (std::same_as<Body, http::FileBody>) {
+                        auto &file = outgoing.template emplace<File>(std::move(header));
+                        boost::beast::error_code ec;
+                        file.file.open(body.path.c_str(), boost::beast::file_mode::scan, ec);
+                        const std::uint64_t size = ec ? 0 : file.file.size(ec);
+                        if (ec || body.offset > size) {
+                            Loggers::App().log_error("प्रपञ्च — Prapancha: Unable to serve {} [{}]: {}",
+                                                     body.path.string(), ec.value(), ec.message());
+                            http::Response failure{http::Status::NotFound, "प्रपञ्च — Prapancha: शून्यम्। Nihil!",
+                                                   &arena};
+                            failure.set_header("Content-Type", "text/html; charset=utf-8");
+                            return prepare(outgoing, arena, std::move(failure), keep_alive);
+                        }
+                        file.offset = body.offset;
+                        file.remaining = std::min(body.length.value_or(size - body.offset), size - body.offset);
+                        file.message.content_length(file.remaining);
+                    } else if constexpr (std::same_as<Body, http::StreamBody>) {
+                        outgoing.template emplace<Stream>(std::move(header), std::move(body), arena);
+                    } else {
+                        outgoing.template emplace<Sized>(std::move(header), std::move(body));
+                    }
+                },
+                std::move(response.body));
+    }
+
+} // namespace mehara::prapancha::outgoing
+
+#endif // PRAPANCHA_SERVER_OUTGOING_H_
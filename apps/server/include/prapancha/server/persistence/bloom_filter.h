@@ -0,0 +1,49 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_PERSISTENCE_BLOOM_FILTER_H_
+#define PRAPANCHA_SERVER_PERSISTENCE_BLOOM_FILTER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace mehara::prapancha::persistence {
+
+    /// BloomFilter Class
+    ///
+    /// A fixed-size set of key hashes that answers "definitely absent" or "possibly present". Keys are given as
+    /// hashes already computed by the caller; each sets seven bits derived from it by double hashing. Bits are
+    /// atomic, so lookups need no lock even while a writer inserts. Nothing can be taken out again: a removed key
+    /// only costs a false positive until the filter is rebuilt.
+    class BloomFilter final {
+    public:
+        static constexpr std::size_t BitsPerKey = 10;
+        static constexpr std::size_t MinimumCapacity = 1024;
+
+        /// Sized for about 1% false positives with up to `capacity` keys.
+        explicit BloomFilter(std::size_t capacity);
+
+        void insert(std::uint64_t hash) noexcept;
+
+        /// False only if no key with this hash has been inserted.
+        [[nodiscard]] bool may_contain(std::uint64_t hash) const noexcept;
+
+        /// Keys inserted so far, counting repeats.
+        [[nodiscard]] std::size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+        /// Keys the filter was sized for; past this its false-positive rate climbs.
+        [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    private:
+        std::size_t capacity_;
+        std::uint64_t mask_; ///< Bit count minus one; the bit count is a power of two.
+        std::unique_ptr<std::atomic<std::uint64_t>[]> words_;
+        std::atomic<std::size_t> size_{0};
+    };
+
+} // namespace mehara::prapancha::persistence
+
+#endif // PRAPANCHA_SERVER_PERSISTENCE_BLOOM_FILTER_H_
@@ -0,0 +1,231 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_PERSISTENCE_CACHED_PERSISTENCE_H_
+#define PRAPANCHA_SERVER_PERSISTENCE_CACHED_PERSISTENCE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <prapancha/server/persistence/persistence.h>
+#include <prapancha/server/uuid.h>
+
+namespace mehara::prapancha {
+
+    namespace persistence {
+
+        /// Sizing of a CachedPersistence; shared by every instantiation so configuration can build it once.
+        struct CacheOptions {
+            static constexpr std::size_t DefaultBudget = 32 * 1024 * 1024;
+            static constexpr std::size_t DefaultShards = 16;
+
+            std::size_t budget = DefaultBudget; ///< Bytes held across all shards; zero disables caching.
+            std::size_t shards = DefaultShards; ///< Rounded up to a power of two.
+        };
+
+    } // namespace persistence
+
+    /// CachedPersistence Class
+    ///
+    /// Read-through cache of decoded models in front of another Persistence. Ids are spread over independently
+    /// locked shards, each holding an equal part of the byte budget in a ring of slots evicted by CLOCK: a hit marks
+    /// its slot, and the hand clears marks until it finds unmarked slots whose eviction makes room. An entry is
+    /// charged its encoded size, when the backing store names a codec, plus its bookkeeping. Ids the backing store
+    /// does not hold are cached too, so repeated misses stay off the disk.
+    ///
+    /// save() and remove() write through and then invalidate the id. Each shard counts its invalidations, and a load
+    /// that raced one does not cache what it read, so a stale model is never put back. Copies share one cache, the
+    /// way controllers share their persistence.
+    template<typename P>
+    class CachedPersistence {
+    public:
+        using ModelType = P::ModelType;
+
+        using Options = persistence::CacheOptions;
+
+        struct Metrics {
+            std::atomic<std::uint64_t> hits{0};
+            std::atomic<std::uint64_t> negative_hits{0}; ///< Hits on an id known to be absent.
+            std::atomic<std::uint64_t> misses{0};
+            std::atomic<std::uint64_t> evictions{0};
+            std::atomic<std::uint64_t> invalidations{0};
+        };
+
+    private:
+        struct Slot {
+            UUID id;
+            std::optional<ModelType> model; ///< Empty for a cached miss.
+            std::size_t bytes = 0; ///< Charged against the shard's budget while occupied.
+            bool occupied = false;
+            bool referenced = false;
+        };
+
+        /// Bookkeeping charged to every entry: its slot and its node in the position map.
+        static constexpr std::size_t EntryOverhead = sizeof(Slot) + sizeof(std::pair<const UUID, std::size_t>) +
+                                                     2 * sizeof(void *);
+
+        struct Shard {
+            std::mutex mutex;
+            std::vector<Slot> slots;
+            std::vector<std::size_t> vacant;
+            std::unordered_map<UUID, std::size_t> positions;
+            std::size_t hand = 0;
+            std::size_t bytes = 0;
+            std::size_t budget = 0;
+            std::uint64_t invalidations = 0;
+
+            void release(const std::size_t position) {
+                Slot &slot = slots[position];
+                positions.erase(slot.id);
+                slot.model.reset();
+                slot.occupied = false;
+                bytes -= slot.bytes;
+                vacant.push_back(position);
+            }
+
+            /// Evicts unmarked slots, clearing marks as the hand passes, until `cost` more bytes fit. Returns a vacant
+            /// slot, growing the ring when none is left.
+            std::size_t claim(const std::size_t cost, Metrics &metrics) {
+                for (; bytes + cost > budget && !positions.empty(); hand = (hand + 1) % slots.size()) {
+                    Slot &slot = slots[hand];
+                    if (slot.occupied && slot.referenced) {
+                        slot.referenced = false;
+                    } else if (slot.occupied) {
+                        release(hand);
+                        metrics.evictions.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                if (vacant.empty()) {
+                    slots.emplace_back();
+                    return slots.size() - 1;
+                }
+                const std::size_t claimed = vacant.back();
+                vacant.pop_back();
+                return claimed;
+            }
+        };
+
+        struct Cache {
+            std::vector<Shard> shards;
+            Metrics metrics;
+
+            explicit Cache(const Options &options) : shards(std::bit_ceil(std::max<std::size_t>(options.shards, 1))) {
+                for (Shard &shard: shards) {
+                    shard.budget = options.budget / shards.size();
+                }
+            }
+
+            Shard &shard(const UUID &id) noexcept { return shards[std::hash<UUID>{}(id) & (shards.size() - 1)]; }
+        };
+
+        P inner_;
+        std::shared_ptr<Cache> cache_;
+
+        /// Bytes an entry holds: the encoded model when the store names its codec, else the model's own footprint.
+        static std::size_t cost(const std::optional<ModelType> &model) {
+            if (!model) {
+                return EntryOverhead;
+            }
+            if constexpr (requires { P::CodecType::encode(*model).size(); }) {
+                return EntryOverhead + P::CodecType::encode(*model).size();
+            } else {
+                return EntryOverhead + sizeof(ModelType);
+            }
+        }
+
+        void invalidate(const UUID &id) {
+            Shard &shard = cache_->shard(id);
+            std::lock_guard lock(shard.mutex);
+            ++shard.invalidations;
+            if (const auto found = shard.positions.find(id); found != shard.positions.end()) {
+                shard.release(found->second);
+            }
+            cache_->metrics.invalidations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    public:
+        explicit CachedPersistence(P inner, const Options options = {}) :
+            inner_(std::move(inner)), cache_(options.budget > 0 ? std::make_shared<Cache>(options) : nullptr) {}
+
+        void save(const ModelType &model) {
+            inner_.save(model);
+            if (cache_) {
+                invalidate(model.id());
+            }
+        }
+
+        std::optional<ModelType> load(const UUID &id) {
+            if (!cache_) {
+                return inner_.load(id);
+            }
+            Shard &shard = cache_->shard(id);
+            std::uint64_t invalidations = 0;
+            {
+                std::lock_guard lock(shard.mutex);
+                if (const auto found = shard.positions.find(id); found != shard.positions.end()) {
+                    Slot &slot = shard.slots[found->second];
+                    slot.referenced = true;
+                    (slot.model ? cache_->metrics.hits : cache_->metrics.negative_hits)
+                            .fetch_add(1, std::memory_order_relaxed);
+                    return slot.model;
+                }
+                invalidations = shard.invalidations;
+            }
+            cache_->metrics.misses.fetch_add(1, std::memory_order_relaxed);
+            auto model = inner_.load(id);
+            // Sized outside the lock; a model too large for its shard's whole budget is not cached at all.
+            const std::size_t bytes = cost(model);
+            std::lock_guard lock(shard.mutex);
+            if (shard.invalidations == invalidations && bytes <= shard.budget && !shard.positions.contains(id)) {
+                const std::size_t position = shard.claim(bytes, cache_->metrics);
+                Slot &slot = shard.slots[position];
+                slot.id = id;
+                if (model) {
+                    slot.model.emplace(*model);
+                }
+                slot.bytes = bytes;
+                slot.occupied = true;
+                slot.referenced = false;
+                shard.bytes += bytes;
+                shard.positions.emplace(id, position);
+            }
+            return model;
+        }
+
+        /// Scans the backing store directly; passing a full scan through the cache would only evict the models
+        /// worth keeping.
+        template<typename Visitor, typename... Arguments>
+        void scan(Visitor &&visit, Arguments &&...arguments) {
+            inner_.scan(std::forward<Visitor>(visit), std::forward<Arguments>(arguments)...);
+        }
+
+        std::vector<ModelType> all() { return inner_.all(); }
+
+        bool remove(const UUID &id) {
+            const bool removed = inner_.remove(id);
+            if (cache_) {
+                invalidate(id);
+            }
+            return removed;
+        }
+
+        /// Cache counters; nullptr when caching is disabled.
+        [[nodiscard]] const Metrics *statistics() const noexcept { return cache_ ? &cache_->metrics : nullptr; }
+
+        [[nodiscard]] const P &inner() const noexcept { return inner_; }
+    };
+
+} // namespace mehara::prapancha
+
+#endif // PRAPANCHA_SERVER_PERSISTENCE_CACHED_PERSISTENCE_H_
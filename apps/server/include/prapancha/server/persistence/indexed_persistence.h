@@ -0,0 +1,346 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_PERSISTENCE_INDEXED_PERSISTENCE_H_
+#define PRAPANCHA_SERVER_PERSISTENCE_INDEXED_PERSISTENCE_H_
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <prapancha/server/logger_registry.h>
+#include <prapancha/server/persistence/bloom_filter.h>
+#include <prapancha/server/persistence/persistence.h>
+#include <prapancha/server/uuid.h>
+
+namespace mehara::prapancha {
+
+    namespace persistence {
+
+        /// Thrown by IndexedPersistence::save when a unique index already maps the model's key to another id.
+        class IndexConflict : public std::runtime_error {
+        public:
+            using std::runtime_error::runtime_error;
+        };
+
+        template<typename>
+        struct Field;
+
+        template<typename S, typename K>
+        struct Field<K S::*> {
+            using State = S;
+            using Key = K;
+        };
+
+        /// Declares an index on a State member, such as `Unique<&UserIdentity<H>::State::username>`, under which
+        /// at most one model may hold any key. A Bloom filter over the keys answers most absent lookups without
+        /// taking the index lock.
+        template<auto Member>
+        struct Unique {
+            using Key = Field<decltype(Member)>::Key;
+            static constexpr auto member = Member;
+
+            std::unordered_map<Key, UUID> ids;
+            std::atomic<std::shared_ptr<BloomFilter>> bloom{std::make_shared<BloomFilter>(0)};
+
+            static std::uint64_t hash(const Key &key) { return std::hash<Key>{}(key); }
+
+            [[nodiscard]] bool conflicts(const Key &key, const UUID &id) const {
+                const auto found = ids.find(key);
+                return found != ids.end() && found->second != id;
+            }
+
+            /// Claims `key` for `id` unless another id holds it; returns whether it did. Rebuilds the filter at
+            /// twice the size once it fills up, which also sheds the bits of removed keys.
+            bool insert(const Key &key, const UUID &id) {
+                if (!ids.try_emplace(key, id).second) {
+                    return false;
+                }
+                const auto filter = bloom.load(std::memory_order_acquire);
+                if (filter->size() < filter->capacity()) {
+                    filter->insert(hash(key));
+                    return true;
+                }
+                auto grown = std::make_shared<BloomFilter>(ids.size() * 2);
+                for (const auto &[held, _]: ids) {
+                    grown->insert(hash(held));
+                }
+                bloom.store(std::move(grown), std::memory_order_release);
+                return true;
+            }
+
+            void erase(const Key &key, const UUID &id) {
+                if (const auto found = ids.find(key); found != ids.end() && found->second == id) {
+                    ids.erase(found);
+                }
+            }
+        };
+
+        /// Declares an index on a State member that many models may share, such as `Multi<&Post::State::author_id>`.
+        template<auto Member>
+        struct Multi {
+            using Key = Field<decltype(Member)>::Key;
+            static constexpr auto member = Member;
+
+            std::unordered_map<Key, std::unordered_set<UUID>> ids;
+
+            [[nodiscard]] static bool conflicts(const Key &, const UUID &) noexcept { return false; }
+
+            bool insert(const Key &key, const UUID &id) {
+                ids[key].insert(id);
+                return true;
+            }
+
+            void erase(const Key &key, const UUID &id) {
+                if (const auto found = ids.find(key); found != ids.end()) {
+                    found->second.erase(id);
+                    if (found->second.empty()) {
+                        ids.erase(found);
+                    }
+                }
+            }
+        };
+
+        template<typename>
+        inline constexpr bool is_unique_index = false;
+
+        template<auto Member>
+        inline constexpr bool is_unique_index<Unique<Member>> = true;
+
+        template<auto A, auto B>
+        inline constexpr bool is_same_member = false;
+
+        template<auto A, auto B>
+            requires std::same_as<decltype(A), decltype(B)>
+        inline constexpr bool is_same_member<A, B> = A == B;
+
+    } // namespace persistence
+
+    /// IndexedPersistence Class
+    ///
+    /// Keeps in-memory secondary indexes over State members in front of another Persistence, so a model can be
+    /// found by a field without scanning the store. The indexes are declared as template arguments and rebuilt
+    /// from a scan of the backing store on construction.
+    ///
+    /// save() and remove() keep the indexes current. Writes to the same id are serialised, writes to different ids
+    /// are not; a save claims its keys before writing through, so two models racing for one unique key cannot both
+    /// be stored, and gives them back if the write fails. A lookup may therefore name a model whose save is still
+    /// in flight. Copies share one set of indexes, the way controllers share their persistence.
+    template<typename P, typename... Indexes>
+    class IndexedPersistence {
+    public:
+        using ModelType = P::ModelType;
+
+    private:
+        static constexpr std::size_t WriterStripes = 64;
+
+        using Keys = std::tuple<typename Indexes::Key...>;
+
+        struct Catalogue {
+            std::shared_mutex mutex;
+            std::tuple<Indexes...> indexes;
+            std::unordered_map<UUID, Keys> rows; ///< The keys each stored model is indexed under.
+            std::array<std::mutex, WriterStripes> writers;
+
+            std::mutex &writer(const UUID &id) noexcept { return writers[std::hash<UUID>{}(id) % WriterStripes]; }
+        };
+
+        P inner_;
+        std::shared_ptr<Catalogue> catalogue_;
+
+        template<auto Member>
+        static constexpr std::size_t position() {
+            constexpr std::array<bool, sizeof...(Indexes)> matches{
+                    persistence::is_same_member<Indexes::member, Member>...};
+            for (std::size_t i = 0; i < matches.size(); ++i) {
+                if (matches[i]) {
+                    return i;
+                }
+            }
+            return matches.size();
+        }
+
+        template<auto Member>
+        using IndexOn = std::tuple_element_t<position<Member>(), std::tuple<Indexes...>>;
+
+        template<auto Member>
+        IndexOn<Member> &index() noexcept {
+            return std::get<position<Member>()>(catalogue_->indexes);
+        }
+
+        static Keys keys_of(const ModelType &model) { return Keys{model.state.*Indexes::member...}; }
+
+        /// Whether any unique index holds one of `keys` for an id other than `id`; catalogue mutex held.
+        bool conflicts(const Keys &keys, const UUID &id) const {
+            return [&]<std::size_t... I>(std::index_sequence<I...>) {
+                return (std::get<I>(catalogue_->indexes).conflicts(std::get<I>(keys), id) || ...);
+            }(std::index_sequence_for<Indexes...>{});
+        }
+
+        /// Indexes `id` under `keys`; returns false if a unique index already held a key for another id.
+        /// Catalogue mutex held exclusively.
+        bool attach(const UUID &id, const Keys &keys) {
+            catalogue_->rows.insert_or_assign(id, keys);
+            return [&]<std::size_t... I>(std::index_sequence<I...>) {
+                return (std::get<I>(catalogue_->indexes).insert(std::get<I>(keys), id) & ...);
+            }(std::index_sequence_for<Indexes...>{});
+        }
+
+        /// Drops `id` from every index and returns the keys it was under; catalogue mutex held exclusively.
+        std::optional<Keys> detach(const UUID &id) {
+            const auto found = catalogue_->rows.find(id);
+            if (found == catalogue_->rows.end()) {
+                return std::nullopt;
+            }
+            Keys keys = std::move(found->second);
+            catalogue_->rows.erase(found);
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                (std::get<I>(catalogue_->indexes).erase(std::get<I>(keys), id), ...);
+            }(std::index_sequence_for<Indexes...>{});
+            return keys;
+        }
+
+        void rebuild() {
+            std::size_t conflicting = 0;
+            inner_.scan([&](ModelType &&model) {
+                if (!attach(model.id(), keys_of(model))) {
+                    ++conflicting;
+                }
+                return persistence::Scan::Continue;
+            });
+            Loggers::App().log_info("प्रपञ्च — Prapancha: Indexed {} {} records.", catalogue_->rows.size(),
+                                    ModelType::model_name);
+            if (conflicting > 0) {
+                Loggers::App().log_warn("प्रपञ्च — Prapancha: {} {} records repeat a unique key; only one of each is "
+                                        "reachable through the index.",
+                                        conflicting, ModelType::model_name);
+            }
+        }
+
+    public:
+        explicit IndexedPersistence(P inner) : inner_(std::move(inner)), catalogue_(std::make_shared<Catalogue>()) {
+            rebuild();
+        }
+
+        /// Throws persistence::IndexConflict, writing nothing, if a unique index holds one of the model's keys for
+        /// another id.
+        void save(const ModelType &model) {
+            const UUID &id = model.id();
+            std::lock_guard writing(catalogue_->writer(id));
+            const Keys keys = keys_of(model);
+            std::optional<Keys> previous;
+            {
+                std::unique_lock lock(catalogue_->mutex);
+                if (conflicts(keys, id)) {
+                    throw persistence::IndexConflict("A unique index already holds this key for another model.");
+                }
+                previous = detach(id);
+                attach(id, keys);
+            }
+            try {
+                inner_.save(model);
+            } catch (...) {
+                std::unique_lock lock(catalogue_->mutex);
+                detach(id);
+                if (previous) {
+                    attach(id, *previous);
+                }
+                throw;
+            }
+        }
+
+        std::optional<ModelType> load(const UUID &id) { return inner_.load(id); }
+
+        template<typename Visitor, typename... Arguments>
+        void scan(Visitor &&visit, Arguments &&...arguments) {
+            inner_.scan(std::forward<Visitor>(visit), std::forward<Arguments>(arguments)...);
+        }
+
+        std::vector<ModelType> all() { return inner_.all(); }
+
+        bool remove(const UUID &id) {
+            std::lock_guard writing(catalogue_->writer(id));
+            const bool removed = inner_.remove(id);
+            std::unique_lock lock(catalogue_->mutex);
+            detach(id);
+            return removed;
+        }
+
+        /// Whether any model is indexed under `key`. For a unique index, most absent keys are answered by the
+        /// Bloom filter alone.
+        template<auto Member>
+        [[nodiscard]] bool contains(const typename IndexOn<Member>::Key &key) {
+            auto &found = index<Member>();
+            if constexpr (persistence::is_unique_index<IndexOn<Member>>) {
+                if (!found.bloom.load(std::memory_order_acquire)->may_contain(found.hash(key))) {
+                    return false;
+                }
+            }
+            std::shared_lock lock(catalogue_->mutex);
+            return found.ids.contains(key);
+        }
+
+        /// Id of the model holding `key` in a unique index.
+        template<auto Member>
+            requires persistence::is_unique_index<IndexOn<Member>>
+        [[nodiscard]] std::optional<UUID> find(const typename IndexOn<Member>::Key &key) {
+            auto &found = index<Member>();
+            if (!found.bloom.load(std::memory_order_acquire)->may_contain(found.hash(key))) {
+                return std::nullopt;
+            }
+            std::shared_lock lock(catalogue_->mutex);
+            if (const auto entry = found.ids.find(key); entry != found.ids.end()) {
+                return entry->second;
+            }
+            return std::nullopt;
+        }
+
+        /// Ids of every model indexed under `key`, in no particular order.
+        template<auto Member>
+            requires(!persistence::is_unique_index<IndexOn<Member>>)
+        [[nodiscard]] std::vector<UUID> find_all(const typename IndexOn<Member>::Key &key) {
+            auto &found = index<Member>();
+            std::shared_lock lock(catalogue_->mutex);
+            if (const auto entry = found.ids.find(key); entry != found.ids.end()) {
+                return {entry->second.begin(), entry->second.end()};
+            }
+            return {};
+        }
+
+        /// The model holding `key` in a unique index, loaded through the backing store.
+        template<auto Member>
+            requires persistence::is_unique_index<IndexOn<Member>>
+        [[nodiscard]] std::optional<ModelType> load_by(const typename IndexOn<Member>::Key &key) {
+            const auto id = find<Member>(key);
+            if (!id) {
+                return std::nullopt;
+            }
+            return inner_.load(*id);
+        }
+
+        /// Models indexed so far.
+        [[nodiscard]] std::size_t size() const {
+            std::shared_lock lock(catalogue_->mutex);
+            return catalogue_->rows.size();
+        }
+
+        [[nodiscard]] const P &inner() const noexcept { return inner_; }
+    };
+
+} // namespace mehara::prapancha
+
+#endif // PRAPANCHA_SERVER_PERSISTENCE_INDEXED_PERSISTENCE_H_
@@ -0,0 +1,97 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_PERSISTENCE_LOG_PERSISTENCE_H_
+#define PRAPANCHA_SERVER_PERSISTENCE_LOG_PERSISTENCE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <prapancha/server/codec/codec.h>
+#include <prapancha/server/persistence/scan.h>
+#include <prapancha/server/persistence/segment_log.h>
+#include <prapancha/server/uuid.h>
+
+namespace mehara::prapancha {
+
+    /// LogPersistence Class
+    ///
+    /// Stores encoded models in a persistence::SegmentLog, so a save is one sequential append rather than a file
+    /// rewrite. Copies share the same log, the way copies of a FilePersistence share a directory.
+    template<typename M, typename C>
+        requires codec::Codec<C, M> && std::convertible_to<typename C::encoded_type, std::string>
+    class LogPersistence {
+    public:
+        using ModelType = M;
+        using CodecType = C;
+
+        explicit LogPersistence(std::filesystem::path path, persistence::SegmentLog::Options options = {}) :
+            log_(std::make_shared<persistence::SegmentLog>(std::move(path), options)) {}
+
+        void save(const M &model) {
+            const std::string data = C::encode(model);
+            log_->put(model.id(), data);
+        }
+
+        std::optional<M> load(const UUID &id) {
+            const auto data = log_->get(id);
+            if (!data) {
+                return std::nullopt;
+            }
+            return C::decode(*data);
+        }
+
+        /// Visits every stored model, reading and decoding records on `options.workers` threads while `visit` sees
+        /// one model at a time; see persistence::scan. `filter` sees each record still encoded and rejects it before
+        /// it is decoded. Ids are snapshotted when the scan starts; a model removed since is skipped.
+        template<typename Visitor, typename Filter = persistence::AcceptAll>
+            requires persistence::ScanVisitor<Visitor, M> && std::predicate<Filter &, typename C::encoded_view>
+        void scan(Visitor &&visit, Filter &&filter = {}, const persistence::ScanOptions options = {}) {
+            const std::vector<UUID> ids = log_->ids();
+            std::atomic<std::size_t> next{0};
+            const auto claim = [&](std::vector<UUID> &keys, const std::size_t count) {
+                const std::size_t first = std::min(next.fetch_add(count, std::memory_order_relaxed), ids.size());
+                const std::size_t last = std::min(first + count, ids.size());
+                keys.insert(keys.end(), ids.begin() + first, ids.begin() + last);
+                return last < ids.size();
+            };
+            const auto load_id = [&](const UUID &id) -> std::optional<M> {
+                const auto data = log_->get(id);
+                if (!data || !filter(typename C::encoded_view(*data))) {
+                    return std::nullopt;
+                }
+                return C::decode(*data);
+            };
+            persistence::scan<UUID>(options, claim, load_id, visit);
+        }
+
+        /// Every stored model at once; prefer scan() for anything large.
+        std::vector<M> all() {
+            std::vector<M> results;
+            scan([&](M &&model) {
+                results.push_back(std::move(model));
+                return persistence::Scan::Continue;
+            });
+            return results;
+        }
+
+        bool remove(const UUID &id) { return log_->erase(id); }
+
+        [[nodiscard]] const persistence::SegmentLog::Metrics &metrics() const noexcept { return log_->metrics(); }
+
+    private:
+        std::shared_ptr<persistence::SegmentLog> log_;
+    };
+
+} // namespace mehara::prapancha
+
+#endif // PRAPANCHA_SERVER_PERSISTENCE_LOG_PERSISTENCE_H_
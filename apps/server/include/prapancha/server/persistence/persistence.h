@@ -5,12 +5,20 @@
 #ifndef PRAPANCHA_SERVER_PERSISTENCE_PERSISTENCE_H_
 #define PRAPANCHA_SERVER_PERSISTENCE_PERSISTENCE_H_
 
+#include <concepts>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <prapancha/server/codec/codec.h>
 #include <prapancha/server/codec/hex_codec.h>
 #include <prapancha/server/model.h>
+#include <prapancha/server/persistence/scan.h>
 #include <prapancha/server/uuid.h>
 
 namespace mehara::prapancha {
@@ -20,7 +28,7 @@ namespace mehara::prapancha {
         requires Model<M>;
         { policy.save(model) } -> std::same_as<void>;
         { policy.load(id) } -> std::same_as<std::optional<M>>;
-        { policy.all() } -> std::same_as<std::vector<M>>;
+        { policy.scan([](M &&) { return persistence::Scan::Continue; }) } -> std::same_as<void>;
         { policy.remove(id) } -> std::same_as<bool>;
     };
 
@@ -29,6 +37,7 @@ namespace mehara::prapancha {
     class FilePersistence {
     public:
         using ModelType = M;
+        using CodecType = C;
 
         explicit FilePersistence(std::filesystem::path path) : directory_(std::move(path)) {
             if (!std::filesystem::exists(directory_)) {
@@ -43,36 +52,50 @@ namespace mehara::prapancha {
         }
 
         std::optional<M> load(const UUID &id) {
-            const auto path = get_path(id);
-            std::ifstream file(path, std::ios::binary | std::ios::ate);
-            if (!file.is_open()) {
+            const auto data = read(get_path(id));
+            if (!data) {
                 return std::nullopt;
             }
-            const std::streamsize size = file.tellg();
-            if (size <= 0) {
-                return std::nullopt;
-            }
-            file.seekg(0, std::ios::beg);
-            std::string buffer(static_cast<std::size_t>(size), '\0');
-            if (!file.read(buffer.data(), size)) {
-                return std::nullopt;
-            }
-            return C::decode(buffer);
+            return C::decode(*data);
         }
 
-        std::vector<M> all() {
-            std::vector<M> results;
+        /// Visits every stored model, reading and decoding files on `options.workers` threads while `visit` sees
+        /// one model at a time; see persistence::scan. `filter` sees each record still encoded and rejects it before
+        /// it is decoded. The directory is walked incrementally, so memory does not grow with the number of files.
+        template<typename Visitor, typename Filter = persistence::AcceptAll>
+            requires persistence::ScanVisitor<Visitor, M> && std::predicate<Filter &, typename C::encoded_view>
+        void scan(Visitor &&visit, Filter &&filter = {}, const persistence::ScanOptions options = {}) {
             if (!std::filesystem::exists(directory_)) {
-                return results;
+                return;
             }
-            for (const auto &entry: std::filesystem::directory_iterator(directory_)) {
-                if (entry.is_regular_file() && entry.path().extension() == ".bin") {
-                    auto id_str = entry.path().stem().string();
-                    if (auto model = load(codec::HexCodec<UUID>::decode(id_str).value())) {
-                        results.push_back(std::move(*model));
+            std::mutex walking;
+            std::filesystem::directory_iterator entries(directory_);
+            const auto claim = [&](std::vector<std::filesystem::path> &paths, const std::size_t count) {
+                std::lock_guard lock(walking);
+                for (; entries != std::filesystem::directory_iterator() && paths.size() < count; ++entries) {
+                    if (entries->is_regular_file() && entries->path().extension() == ".bin") {
+                        paths.push_back(entries->path());
                     }
                 }
-            }
+                return entries != std::filesystem::directory_iterator();
+            };
+            const auto load_path = [&](const std::filesystem::path &path) -> std::optional<M> {
+                const auto data = read(path);
+                if (!data || !filter(typename C::encoded_view(*data))) {
+                    return std::nullopt;
+                }
+                return C::decode(*data);
+            };
+            persistence::scan<std::filesystem::path>(options, claim, load_path, visit);
+        }
+
+        /// Every stored model at once; prefer scan() for anything large.
+        std::vector<M> all() {
+            std::vector<M> results;
+            scan([&](M &&model) {
+                results.push_back(std::move(model));
+                return persistence::Scan::Continue;
+            });
             return results;
         }
 
@@ -84,6 +107,23 @@ namespace mehara::prapancha {
         [[nodiscard]] std::filesystem::path get_path(const UUID &id) const {
             return directory_ / (codec::HexCodec<UUID>::encode(id) + ".bin");
         }
+
+        static std::optional<std::string> read(const std::filesystem::path &path) {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file.is_open()) {
+                return std::nullopt;
+            }
+            const std::streamsize size = file.tellg();
+            if (size <= 0) {
+                return std::nullopt;
+            }
+            file.seekg(0, std::ios::beg);
+            std::string buffer(static_cast<std::size_t>(size), '\0');
+            if (!file.read(buffer.data(), size)) {
+                return std::nullopt;
+            }
+            return buffer;
+        }
     };
 
     namespace persistence {
@@ -0,0 +1,123 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_PERSISTENCE_SCAN_H_
+#define PRAPANCHA_SERVER_PERSISTENCE_SCAN_H_
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mehara::prapancha::persistence {
+
+    /// What a scan visitor wants next.
+    enum class Scan { Continue, Stop };
+
+    struct ScanOptions {
+        static constexpr std::size_t DefaultBatch = 64;
+        static constexpr std::size_t DefaultParallelThreshold = 1024;
+
+        std::size_t workers = 0; ///< Threads reading and decoding, the caller included; zero uses one per core.
+        std::size_t batch = DefaultBatch; ///< Keys a worker claims at a time.
+        std::size_t parallel_threshold = DefaultParallelThreshold; ///< Keys the caller scans alone before helpers.
+    };
+
+    /// Filter that lets every encoded record through to decoding.
+    struct AcceptAll {
+        constexpr bool operator()(const auto &) const noexcept { return true; }
+    };
+
+    template<typename V, typename M>
+    concept ScanVisitor = std::invocable<V &, M &&> && std::same_as<std::invoke_result_t<V &, M &&>, Scan>;
+
+    /// Runs a scan over `options.workers` threads. Each worker claims a batch of keys through `claim`, which
+    /// appends at most the given count and returns false once the source is exhausted, then turns each key into a
+    /// model through `read`, which may return nothing for a record that is gone, corrupt or filtered out. Models
+    /// are handed to `visit` one at a time, so the visitor needs no locking of its own, in no particular order.
+    ///
+    /// A worker holds one batch of keys and one model, so memory stays bounded by the worker count however large
+    /// the store is. Once `visit` returns Scan::Stop, workers abandon their batches and no further model is
+    /// visited. The first exception thrown by any callback stops the scan and is rethrown to the caller.
+    ///
+    /// The caller scans the first `options.parallel_threshold` keys alone, and helper threads are only started if
+    /// the source still has keys after that. A small store, or a visitor that stops early, never pays for threads.
+    template<typename Key, typename Claim, typename Read, typename Visit>
+    void scan(const ScanOptions &options, Claim &&claim, Read &&read, Visit &&visit) {
+        std::atomic<bool> stopped{false};
+        std::mutex visiting;
+        std::exception_ptr error;
+        const std::size_t batch = std::max<std::size_t>(options.batch, 1);
+        // Scans until the source is exhausted, the scan stops, or `budget` keys have been claimed. Returns true only
+        // in the last case, when keys may remain.
+        const auto work = [&](std::size_t budget) {
+            try {
+                std::vector<Key> keys;
+                keys.reserve(batch);
+                while (!stopped.load(std::memory_order_relaxed)) {
+                    if (budget == 0) {
+                        return true;
+                    }
+                    keys.clear();
+                    const bool more = claim(keys, std::min(batch, budget));
+                    budget -= std::min(budget, keys.size());
+                    if (!more && keys.empty()) {
+                        return false;
+                    }
+                    for (const Key &key: keys) {
+                        if (stopped.load(std::memory_order_relaxed)) {
+                            return false;
+                        }
+                        auto model = read(key);
+                        if (!model) {
+                            continue;
+                        }
+                        std::lock_guard lock(visiting);
+                        if (stopped.load(std::memory_order_relaxed)) {
+                            return false;
+                        }
+                        if (visit(std::move(*model)) == Scan::Stop) {
+                            stopped.store(true, std::memory_order_relaxed);
+                        }
+                    }
+                    if (!more) {
+                        return false;
+                    }
+                }
+            } catch (...) {
+                std::lock_guard lock(visiting);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                stopped.store(true, std::memory_order_relaxed);
+            }
+            return false;
+        };
+        const std::size_t workers =
+                options.workers > 0 ? options.workers : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+        if (work(workers > 1 ? options.parallel_threshold : unbounded)) {
+            std::vector<std::jthread> helpers;
+            helpers.reserve(workers - 1);
+            for (std::size_t i = 1; i < workers; ++i) {
+                helpers.emplace_back(work, unbounded);
+            }
+            work(unbounded);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+} // namespace mehara::prapancha::persistence
+
+#endif // PRAPANCHA_SERVER_PERSISTENCE_SCAN_H_
@@ -0,0 +1,180 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_PERSISTENCE_SEGMENT_LOG_H_
+#define PRAPANCHA_SERVER_PERSISTENCE_SEGMENT_LOG_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <prapancha/server/uuid.h>
+
+namespace mehara::prapancha::persistence {
+
+    /// SegmentLog Class
+    ///
+    /// An append-only store of byte records keyed by UUID. Every write, including a removal, appends one frame to
+    /// the active segment file: a header carrying a CRC-32C, the payload length, the kind of write and the id,
+    /// followed by the payload. Once the active segment passes the configured size it is sealed and a new one
+    /// started. An in-memory index maps each id to its newest frame; opening the log rebuilds it by scanning the
+    /// segments in order, and a torn frame at the end of the newest segment, left by a crash mid-write, is cut off.
+    ///
+    /// A background thread rewrites sealed segments whose frames are mostly superseded, appending the frames still
+    /// live and deleting the old file. A tombstone is carried over only while some segment still holds a superseded
+    /// version of its id, so once those are compacted away the tombstone goes too. Reads never take the write lock;
+    /// a read racing a compaction finishes against the file it started on.
+    ///
+    /// Writes are group-committed. Each put or erase joins a queue; the first writer to find no commit running
+    /// becomes the leader, appends everything queued as one write, syncs once if asked to and completes the whole
+    /// batch, while writers arriving meanwhile form the next batch. A write is visible to readers only once it has
+    /// been committed under the configured durability.
+    class SegmentLog final {
+    public:
+        /// When a write counts as committed.
+        enum class Durability {
+            None, ///< Once written to the page cache; a crash may lose recent writes but never tears older ones.
+            Batched, ///< Once the batch it joined has been flushed with a single fdatasync.
+            PerWrite ///< Once flushed on its own; writes are not grouped.
+        };
+
+        struct Options {
+            static constexpr std::uint64_t DefaultSegmentSize = 64ULL << 20;
+            static constexpr double DefaultCompactionRatio = 0.5;
+            static constexpr std::chrono::milliseconds DefaultCompactionInterval{30'000};
+
+            std::uint64_t segment_size = DefaultSegmentSize; ///< Bytes after which the active segment is sealed.
+            double compaction_ratio = DefaultCompactionRatio; ///< Sealed segments less live than this are rewritten.
+            std::chrono::milliseconds compaction_interval = DefaultCompactionInterval; ///< Zero disables the thread.
+            Durability durability = Durability::Batched;
+        };
+
+        /// Running totals. A commit is one append, and one flush unless durability is None; latency runs from the
+        /// leader taking the batch until the batch is visible.
+        struct Metrics {
+            std::atomic<std::uint64_t> commits{0};
+            std::atomic<std::uint64_t> writes{0};
+            std::atomic<std::uint64_t> syncs{0};
+            std::atomic<std::uint64_t> peak_batch{0};
+            std::atomic<std::uint64_t> commit_nanoseconds{0};
+            std::atomic<std::uint64_t> peak_commit_nanoseconds{0};
+        };
+
+    private:
+        enum class Kind : std::uint8_t { Put = 1, Tombstone = 2 };
+
+        /// A write waiting in, or being committed from, the group-commit queue.
+        struct Pending {
+            UUID id;
+            Kind kind;
+            std::string frame;
+            bool done = false;
+            bool existed = false; ///< For tombstones, whether the id was present when the batch applied it.
+            std::exception_ptr error;
+        };
+
+        struct Segment {
+            std::uint64_t number;
+            std::filesystem::path path;
+            int fd;
+            std::uint64_t size = 0; ///< Bytes appended; guarded by writer_.
+            std::uint64_t live = 0; ///< Bytes of frames the index points at; guarded by index_mutex_.
+
+            Segment(std::uint64_t number, std::filesystem::path path, int fd) noexcept;
+            Segment(const Segment &) = delete;
+            Segment &operator=(const Segment &) = delete;
+            ~Segment();
+        };
+
+        struct Location {
+            std::shared_ptr<Segment> segment;
+            std::uint64_t offset;
+            std::uint64_t length; ///< Whole frame, header included.
+        };
+
+        std::filesystem::path directory_;
+        Options options_;
+        std::mutex writer_;
+        std::map<std::uint64_t, std::shared_ptr<Segment>> segments_; ///< Guarded by writer_.
+        std::shared_ptr<Segment> active_; ///< Guarded by writer_.
+        mutable std::shared_mutex index_mutex_;
+        std::unordered_map<UUID, Location> index_;
+        std::unordered_map<UUID, std::uint64_t> superseded_; ///< Stale put frames on disk; guarded by index_mutex_.
+        std::mutex queue_mutex_;
+        std::condition_variable committed_;
+        std::vector<Pending *> queue_; ///< Guarded by queue_mutex_.
+        bool leading_ = false; ///< A leader is committing; guarded by queue_mutex_.
+        Metrics metrics_;
+        std::mutex wake_mutex_;
+        std::condition_variable_any wake_;
+        std::jthread compactor_;
+
+        std::shared_ptr<Segment> open_segment(std::uint64_t number, bool create);
+        void recover();
+
+        /// Appends whole frames to the active segment, sealing it first if they would overflow it; writer_ held.
+        Location append(std::string_view frames);
+
+        /// Points `id` at `location`, moving the live bytes of any frame it replaces; index_mutex_ held.
+        void place(const UUID &id, const Location &location);
+
+        /// Drops `id` from the index for a tombstone; returns whether it was present. index_mutex_ held.
+        bool forget(const UUID &id);
+
+        /// Queues `pending` and returns once a batch containing it has committed, leading that batch if no other
+        /// writer is. Rethrows the batch's failure.
+        void commit(Pending &pending);
+
+        /// Appends, flushes and applies one batch in order; failures are stored in the batch's entries.
+        void write(std::span<Pending *const> batch) noexcept;
+
+        void compact(const std::shared_ptr<Segment> &segment);
+
+    public:
+        /// Opens the log in `directory`, creating it if needed, and rebuilds the index. Throws std::system_error if
+        /// a segment cannot be opened or read.
+        SegmentLog(std::filesystem::path directory, Options options);
+
+        SegmentLog(const SegmentLog &) = delete;
+        SegmentLog &operator=(const SegmentLog &) = delete;
+
+        /// Stops compaction and flushes the active segment.
+        ~SegmentLog();
+
+        /// Appends `payload` as the newest version of `id` and returns once it is committed. Throws
+        /// std::system_error if the write or its flush fails.
+        void put(const UUID &id, std::string_view payload);
+
+        /// Newest payload of `id`, or nothing if it is absent or its frame fails the CRC check.
+        [[nodiscard]] std::optional<std::string> get(const UUID &id) const;
+
+        /// Appends a tombstone for `id`. Returns false, writing nothing, if the id is absent.
+        bool erase(const UUID &id);
+
+        /// Every id currently stored.
+        [[nodiscard]] std::vector<UUID> ids() const;
+
+        /// Rewrites every sealed segment whose live share has fallen below the compaction ratio.
+        void compact();
+
+        [[nodiscard]] const Metrics &metrics() const noexcept { return metrics_; }
+    };
+
+} // namespace mehara::prapancha::persistence
+
+#endif // PRAPANCHA_SERVER_PERSISTENCE_SEGMENT_LOG_H_
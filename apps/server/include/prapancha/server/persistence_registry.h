@@ -5,33 +5,76 @@
 #ifndef PRAPANCHA_SERVER_PERSISTENCE_REGISTRY_H_
 #define PRAPANCHA_SERVER_PERSISTENCE_REGISTRY_H_
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <variant>
 
 #include <prapancha/security/hasher.h>
 #include <prapancha/server/codec/json_codec.h>
 #include <prapancha/server/codec/json_model_codec.h>
+#include <prapancha/server/configuration.h>
 #include <prapancha/server/model.h>
 
+#include <prapancha/server/persistence/cached_persistence.h>
+#include <prapancha/server/persistence/indexed_persistence.h>
+#include <prapancha/server/persistence/log_persistence.h>
 #include <prapancha/server/persistence/persistence.h>
 
 namespace mehara::prapancha {
 
+    template<typename M>
+    using CachedFilePersistence = CachedPersistence<FilePersistence<M, codec::JsonCodec<M>>>;
+
+    template<typename M>
+    using CachedLogPersistence = CachedPersistence<LogPersistence<M, codec::JsonCodec<M>>>;
+
+    /// Indexes user identities by username, so registration and login never scan the store.
+    template<typename P>
+    using UsernameIndexedPersistence = IndexedPersistence<P, persistence::Unique<&P::ModelType::State::username>>;
+
     using UserIdentityPersistence =
-            std::variant<FilePersistence<UserIdentity<security::Argon2id>,
-                                         codec::JsonCodec<UserIdentity<security::Argon2id>>>,
-                         FilePersistence<UserIdentity<security::Sha256>,
-                                         codec::JsonCodec<UserIdentity<security::Sha256>>>>;
+            std::variant<UsernameIndexedPersistence<CachedFilePersistence<UserIdentity<security::Argon2id>>>,
+                         UsernameIndexedPersistence<CachedFilePersistence<UserIdentity<security::Sha256>>>,
+                         UsernameIndexedPersistence<CachedLogPersistence<UserIdentity<security::Argon2id>>>,
+                         UsernameIndexedPersistence<CachedLogPersistence<UserIdentity<security::Sha256>>>>;
 
     struct PersistenceRegistry {
         inline static std::unique_ptr<UserIdentityPersistence> user_identity_persistence;
 
+        static persistence::SegmentLog::Durability
+        durability(const configuration::Configuration::Persistence::Durability durability) noexcept {
+            using enum configuration::Configuration::Persistence::Durability;
+            switch (durability) {
+                case None:
+                    return persistence::SegmentLog::Durability::None;
+                case PerWrite:
+                    return persistence::SegmentLog::Durability::PerWrite;
+                case Batched:
+                    break;
+            }
+            return persistence::SegmentLog::Durability::Batched;
+        }
+
         template<typename PasswordBinding>
-        static void initialize_user_identity(const std::string &file_path) {
-            using TargetPersistence =
-                    FilePersistence<UserIdentity<PasswordBinding>, codec::JsonCodec<UserIdentity<PasswordBinding>>>;
-            user_identity_persistence =
-                    std::make_unique<UserIdentityPersistence>(std::in_place_type<TargetPersistence>, file_path);
+        static void initialize_user_identity(const std::string &file_path,
+                                             const configuration::Configuration::Persistence &settings) {
+            using Identity = UserIdentity<PasswordBinding>;
+            using Codec = codec::JsonCodec<Identity>;
+            persistence::CacheOptions cache;
+            cache.budget = static_cast<std::size_t>(settings.cache_memory) * 1024 * 1024;
+            if (settings.engine == configuration::Configuration::Persistence::Engine::Log) {
+                persistence::SegmentLog::Options options;
+                options.segment_size = static_cast<std::uint64_t>(settings.segment_size) * 1024 * 1024;
+                options.durability = durability(settings.durability);
+                user_identity_persistence = std::make_unique<UserIdentityPersistence>(
+                        std::in_place_type<UsernameIndexedPersistence<CachedLogPersistence<Identity>>>,
+                        CachedLogPersistence<Identity>(LogPersistence<Identity, Codec>(file_path, options), cache));
+                return;
+            }
+            user_identity_persistence = std::make_unique<UserIdentityPersistence>(
+                    std::in_place_type<UsernameIndexedPersistence<CachedFilePersistence<Identity>>>,
+                    CachedFilePersistence<Identity>(FilePersistence<Identity, Codec>(file_path), cache));
         }
     };
 
@@ -13,7 +13,7 @@
 namespace mehara::prapancha::policy {
 
     struct WithRequest {
-        http::Request request;
+        http::RequestView request;
     };
 
     struct WithIdentity {
@@ -39,7 +39,7 @@ namespace mehara::prapancha::policy {
     concept IsAuthorizationAttestation = std::same_as<T, WithAdminAttestation> || std::same_as<T, WithStaffAttestation>;
 
     template<typename T>
-    concept HasRequest = requires(T v) { [](http::Request &) {}(v.request); };
+    concept HasRequest = requires(T v) { [](http::RequestView &) {}(v.request); };
 
     template<typename T>
     concept HasRole = requires(T v) {
@@ -47,7 +47,7 @@ namespace mehara::prapancha::policy {
     };
 
     namespace internal {
-        inline Result<WithIdentity> authenticate(const http::Request &request) {
+        inline Result<WithIdentity> authenticate(const http::RequestView &request) {
             if constexpr (true) {
                 return {WithIdentity{}};
             }
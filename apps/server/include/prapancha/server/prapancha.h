@@ -7,7 +7,8 @@
 
 namespace mehara::prapancha {
 
-    void run(int argc, char *argv[]);
+    /// Serves until a signal arrives. Returns the process exit status; non-zero if the server could not start.
+    int run(int argc, char *argv[]);
 
 }
 
@@ -0,0 +1,103 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_RESPONDER_H_
+#define PRAPANCHA_SERVER_RESPONDER_H_
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <prapancha/server/http.h>
+
+namespace mehara::prapancha::http {
+
+    /// @brief Move-only completion handler that carries a request's response back to its transport.
+    ///
+    /// The callable is always stored inline; one that does not fit in Capacity, or whose move may throw, is rejected
+    /// at compile time instead of spilling to the heap. Every transport's send lambda is a shared pointer to its
+    /// session plus a stream or sequence number, so handing a request from the session through the router to a
+    /// controller allocates nothing, and each hop is a relocation of a few words rather than a copy.
+    class Responder {
+    public:
+        static constexpr std::size_t Capacity = 4 * sizeof(void *);
+
+    private:
+        struct Operations {
+            void (*invoke)(void *callable, Response &&response);
+            void (*relocate)(void *from, void *to) noexcept; ///< Move-constructs into `to` and destroys `from`.
+            void (*destroy)(void *callable) noexcept;
+        };
+
+        template<typename F>
+        static constexpr Operations operations{
+                [](void *callable, Response &&response) {
+                    std::invoke(*static_cast<F *>(callable), std::move(response));
+                },
+                [](void *from, void *to) noexcept {
+                    ::new (to) F(std::move(*static_cast<F *>(from)));
+                    std::destroy_at(static_cast<F *>(from));
+                },
+                [](void *callable) noexcept { std::destroy_at(static_cast<F *>(callable)); }};
+
+        alignas(std::max_align_t) std::byte storage_[Capacity];
+        const Operations *operations_ = nullptr;
+
+        void reset() noexcept {
+            if (operations_ != nullptr) {
+                operations_->destroy(storage_);
+                operations_ = nullptr;
+            }
+        }
+
+    public:
+        Responder() noexcept = default;
+
+        template<typename F>
+            requires(!std::same_as<std::remove_cvref_t<F>, Responder>) &&
+                    std::invocable<std::remove_cvref_t<F> &, Response &&>
+        Responder(F &&callable) noexcept(std::is_nothrow_constructible_v<std::remove_cvref_t<F>, F>) {
+            using Callable = std::remove_cvref_t<F>;
+            static_assert(sizeof(Callable) <= Capacity, "Responder callable does not fit inline.");
+            static_assert(alignof(Callable) <= alignof(std::max_align_t), "Responder callable is over-aligned.");
+            static_assert(std::is_nothrow_move_constructible_v<Callable>,
+                          "Responder callable must move without throwing.");
+            ::new (static_cast<void *>(storage_)) Callable(std::forward<F>(callable));
+            operations_ = &operations<Callable>;
+        }
+
+        Responder(Responder &&other) noexcept : operations_(std::exchange(other.operations_, nullptr)) {
+            if (operations_ != nullptr) {
+                operations_->relocate(other.storage_, storage_);
+            }
+        }
+
+        Responder &operator=(Responder &&other) noexcept {
+            if (this != &other) {
+                reset();
+                operations_ = std::exchange(other.operations_, nullptr);
+                if (operations_ != nullptr) {
+                    operations_->relocate(other.storage_, storage_);
+                }
+            }
+            return *this;
+        }
+
+        Responder(const Responder &) = delete;
+        Responder &operator=(const Responder &) = delete;
+
+        ~Responder() { reset(); }
+
+        [[nodiscard]] explicit operator bool() const noexcept { return operations_ != nullptr; }
+
+        void operator()(Response &&response) { operations_->invoke(storage_, std::move(response)); }
+    };
+
+} // namespace mehara::prapancha::http
+
+#endif // PRAPANCHA_SERVER_RESPONDER_H_
@@ -0,0 +1,247 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_ROUTE_INDEX_H_
+#define PRAPANCHA_SERVER_ROUTE_INDEX_H_
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+
+#include <prapancha/server/uuid.h>
+
+/// @brief Compile-time lookup structures behind Router.
+namespace mehara::prapancha::routing {
+
+    /// FNV-1a over the key. It is the only pass a lookup makes over the target before the final comparison.
+    [[nodiscard]] constexpr std::uint64_t fingerprint(const std::string_view key) noexcept {
+        std::uint64_t hash = 0xcbf29ce484222325ULL;
+        for (const char c: key) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    /// splitmix64 finalizer; spreads one fingerprint over the slots differently for every seed.
+    [[nodiscard]] constexpr std::uint64_t scatter(const std::uint64_t fingerprint, const std::uint64_t seed) noexcept {
+        std::uint64_t z = fingerprint + seed * 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /// Segments of a route pattern that capture part of the request path instead of matching it literally. A
+    /// parameter is a whole segment `{name}` or `{name:uuid}`; the latter only matches 32 hex digits. A `*` as the
+    /// final segment captures the rest of the path, slashes included, under the name `*`.
+    [[nodiscard]] constexpr bool is_parameterized(const std::string_view pattern) noexcept {
+        return pattern.find_first_of("{*") != std::string_view::npos;
+    }
+
+    /// Literal part of a pattern in front of its first parameter; a lookup hashes this much of the request path.
+    [[nodiscard]] constexpr std::string_view literal_prefix(const std::string_view pattern) noexcept {
+        return pattern.substr(0, std::min(pattern.find_first_of("{*"), pattern.size()));
+    }
+
+    namespace internal {
+        struct Parameter {
+            std::string_view name;
+            std::string_view constraint;
+            std::size_t end; ///< Pattern offset just past the closing brace.
+        };
+
+        [[nodiscard]] constexpr Parameter parse_parameter(const std::string_view pattern, const std::size_t open) {
+            const std::size_t close = pattern.find('}', open);
+            if (close == std::string_view::npos) {
+                throw std::invalid_argument("Route parameter is missing its closing brace.");
+            }
+            const std::string_view spec = pattern.substr(open + 1, close - open - 1);
+            const std::size_t colon = spec.find(':');
+            const std::string_view constraint = colon == std::string_view::npos ? "" : spec.substr(colon + 1);
+            const Parameter parameter{spec.substr(0, colon), constraint, close + 1};
+            if (parameter.name.empty() || parameter.name.find_first_of("{/") != std::string_view::npos) {
+                throw std::invalid_argument("Route parameter needs a name.");
+            }
+            if (!parameter.constraint.empty() && parameter.constraint != "uuid") {
+                throw std::invalid_argument("Route parameter constraint is not known.");
+            }
+            return parameter;
+        }
+
+        [[nodiscard]] constexpr bool is_hex(const std::string_view value) noexcept {
+            return std::ranges::all_of(value, [](const char c) {
+                return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+            });
+        }
+    } // namespace internal
+
+    /// Checks that every capture in a pattern spans a whole segment and returns how many there are.
+    [[nodiscard]] consteval std::size_t count_parameters(const std::string_view pattern) {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < pattern.size(); ++i) {
+            if (pattern[i] != '{' && pattern[i] != '*') {
+                continue;
+            }
+            if (i == 0 || pattern[i - 1] != '/') {
+                throw std::invalid_argument("Route parameter must start a path segment.");
+            }
+            ++count;
+            if (pattern[i] == '*') {
+                if (i + 1 != pattern.size()) {
+                    throw std::invalid_argument("Route wildcard must be the last path segment.");
+                }
+                continue;
+            }
+            i = internal::parse_parameter(pattern, i).end;
+            if (i != pattern.size() && pattern[i] != '/') {
+                throw std::invalid_argument("Route parameter must end a path segment.");
+            }
+        }
+        return count;
+    }
+
+    /// Names of a pattern's captures in the order they appear, padded with empty views up to Capacity.
+    template<std::size_t Capacity>
+    [[nodiscard]] consteval std::array<std::string_view, Capacity> parameter_names(const std::string_view pattern) {
+        if (count_parameters(pattern) > Capacity) {
+            throw std::invalid_argument("Route declares more parameters than a request can carry.");
+        }
+        std::array<std::string_view, Capacity> names{};
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < pattern.size(); ++i) {
+            if (pattern[i] == '*') {
+                names[count++] = "*";
+            } else if (pattern[i] == '{') {
+                const auto parameter = internal::parse_parameter(pattern, i);
+                names[count++] = parameter.name;
+                i = parameter.end - 1;
+            }
+        }
+        return names;
+    }
+
+    /// Matches a request path against a validated pattern, storing each capture as a view into `path`. The walk is
+    /// a single pass over both strings; captures are never empty except for a trailing wildcard.
+    template<std::size_t Capacity>
+    [[nodiscard]] constexpr bool match(const std::string_view pattern, const std::string_view path,
+                                       std::array<std::string_view, Capacity> &values) noexcept {
+        std::size_t i = 0;
+        std::size_t j = 0;
+        std::size_t count = 0;
+        while (i < pattern.size()) {
+            if (pattern[i] == '*') {
+                values[count] = path.substr(j);
+                return true;
+            }
+            if (pattern[i] == '{') {
+                const std::size_t close = pattern.find('}', i);
+                const std::size_t end = std::min(path.find('/', j), path.size());
+                const std::string_view value = path.substr(j, end - j);
+                if (value.empty() || (pattern.substr(i, close - i).ends_with(":uuid") &&
+                                      (value.size() != UUID::hex_length || !internal::is_hex(value)))) {
+                    return false;
+                }
+                values[count++] = value;
+                i = close + 1;
+                j = end;
+                continue;
+            }
+            if (j == path.size() || pattern[i] != path[j]) {
+                return false;
+            }
+            ++i;
+            ++j;
+        }
+        return j == path.size();
+    }
+
+    /// PerfectHash Class
+    ///
+    /// Collision-free index over N distinct keys, built during constant evaluation by hash and displace. Keys are
+    /// grouped into buckets by fingerprint and each bucket, largest first, is given the first seed that scatters all
+    /// of its keys into free slots. A lookup costs one fingerprint, two table loads and one comparison, whatever N is.
+    template<std::size_t N>
+    class PerfectHash {
+    public:
+        static constexpr std::size_t npos = N;
+
+    private:
+        static constexpr std::size_t buckets = std::bit_ceil(std::max<std::size_t>(N, 1));
+        static constexpr std::size_t slots = 2 * buckets;
+        static constexpr std::uint32_t seed_limit = 1 << 20;
+
+        std::array<std::string_view, N> keys_;
+        std::array<std::uint32_t, buckets> seeds_{};
+        std::array<std::uint32_t, slots> slots_{}; ///< Key index plus one; zero marks a free slot.
+
+        [[nodiscard]] static constexpr std::size_t bucket_of(const std::uint64_t print) noexcept {
+            return scatter(print, 0) & (buckets - 1);
+        }
+
+        [[nodiscard]] static constexpr std::size_t slot_of(const std::uint64_t print,
+                                                           const std::uint32_t seed) noexcept {
+            return scatter(print, seed) & (slots - 1);
+        }
+
+    public:
+        consteval explicit PerfectHash(const std::array<std::string_view, N> &keys) : keys_(keys) {
+            std::array<std::uint64_t, N> prints{};
+            std::array<std::size_t, buckets> sizes{};
+            for (std::size_t i = 0; i < N; ++i) {
+                prints[i] = fingerprint(keys[i]);
+                ++sizes[bucket_of(prints[i])];
+            }
+            std::array<std::size_t, N> order{};
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::ranges::sort(order, [&](const std::size_t a, const std::size_t b) {
+                const std::size_t bucket_a = bucket_of(prints[a]);
+                const std::size_t bucket_b = bucket_of(prints[b]);
+                return sizes[bucket_a] != sizes[bucket_b] ? sizes[bucket_a] > sizes[bucket_b] : bucket_a < bucket_b;
+            });
+            for (std::size_t first = 0; first < N;) {
+                const std::size_t bucket = bucket_of(prints[order[first]]);
+                const std::size_t last = first + sizes[bucket];
+                std::uint32_t seed = 1;
+                for (;; ++seed) {
+                    if (seed == seed_limit) {
+                        throw std::invalid_argument("Route paths cannot be separated; is one declared twice?");
+                    }
+                    std::array<bool, slots> taken{};
+                    bool placed = true;
+                    for (std::size_t i = first; i < last && placed; ++i) {
+                        const std::size_t slot = slot_of(prints[order[i]], seed);
+                        placed = slots_[slot] == 0 && !taken[slot];
+                        taken[slot] = true;
+                    }
+                    if (placed) {
+                        break;
+                    }
+                }
+                seeds_[bucket] = seed;
+                for (std::size_t i = first; i < last; ++i) {
+                    slots_[slot_of(prints[order[i]], seed)] = static_cast<std::uint32_t>(order[i] + 1);
+                }
+                first = last;
+            }
+        }
+
+        /// Index of `key` in the array the table was built from, or npos.
+        [[nodiscard]] constexpr std::size_t find(const std::string_view key) const noexcept {
+            const std::uint64_t print = fingerprint(key);
+            const std::uint32_t slot = slots_[slot_of(print, seeds_[bucket_of(print)])];
+            if (slot == 0 || keys_[slot - 1] != key) {
+                return npos;
+            }
+            return slot - 1;
+        }
+    };
+
+} // namespace mehara::prapancha::routing
+
+#endif // PRAPANCHA_SERVER_ROUTE_INDEX_H_
@@ -6,14 +6,25 @@
 #define PRAPANCHA_SERVER_ROUTER_H_
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <string_view>
+#include <utility>
 
 #include <prapancha/server/controller/controller_provider.h>
 #include <prapancha/server/http.h>
+#include <prapancha/server/responder.h>
+#include <prapancha/server/route_index.h>
 
 namespace mehara::prapancha {
 
+    /// Route path, either literal or a pattern with `{name}`, `{name:uuid}` and trailing `*` segments. Patterns are
+    /// checked when the router is instantiated, so a malformed one fails the build rather than a request.
     template<std::size_t N>
     struct Path {
         char data[N]{};
@@ -26,37 +37,275 @@ namespace mehara::prapancha {
     template<std::size_t N>
     Path(const char (&)[N]) -> Path<N>;
 
-    template<Path Path, http::Method Verb, auto Handler>
-        requires requires(http::Request &request) { Handler(std::move(request), [](http::Response &&) {}); }
+    template<Path Path, http::Method Verb, auto Handler, http::BodyLimit Limit = http::BodyLimit{}>
+        requires requires(http::RequestView request, http::Responder responder) {
+            Handler(std::move(request), std::move(responder));
+        }
     struct Route {
         static constexpr std::string_view path = Path.view();
         static constexpr http::Method method = Verb;
+        static constexpr http::BodyLimit body_limit = Limit;
 
-        template<typename Request, typename Responder>
-            requires std::derived_from<std::decay_t<Request>, http::Request> &&
-                     std::invocable<Responder, http::Response &&> &&
-                     std::same_as<std::invoke_result_t<Responder, http::Response &&>, void>
-        static void execute(Request &&request, Responder &&responder) {
-            Handler(std::forward<Request>(request), std::forward<Responder>(responder));
+        static void execute(http::RequestView &&request, http::Responder &&responder) {
+            Handler(std::move(request), std::move(responder));
         }
     };
 
+    /// @brief Static route table resolved at compile time.
+    ///
+    /// The distinct literal route paths are indexed by a routing::PerfectHash, so resolving a target costs one hash
+    /// and one comparison however many routes are declared, and an unknown path is rejected just as quickly.
+    /// Parameterized patterns are indexed the same way by their literal prefix: a lookup hashes the target's prefix
+    /// at each prefix length the table declares, then walks the few patterns sharing a prefix to capture their
+    /// parameters. A literal path always wins over a pattern that also matches it. Each path keeps the route serving
+    /// every method on it, which is how a known path requested with the wrong method is answered with 405 and an
+    /// Allow header instead of 404.
     template<typename... Routes>
     struct Router {
-        template<typename Req, typename Send>
-        static void dispatch(Req &&req, Send &&send) {
-            std::string_view target = req.target;
-            if (auto pos = target.find('?'); pos != std::string_view::npos) {
+    private:
+        static constexpr std::size_t route_count = sizeof...(Routes);
+        static constexpr std::size_t method_count = static_cast<std::size_t>(http::Method::Unknown) + 1;
+        static constexpr std::array<std::string_view, route_count> declared_paths{Routes::path...};
+        static constexpr std::array<http::Method, route_count> declared_methods{Routes::method...};
+        static constexpr std::array<http::BodyLimit, route_count> body_limits{Routes::body_limit...};
+
+        static consteval std::size_t count_paths() {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < route_count; ++i) {
+                const auto previous = declared_paths.begin() + static_cast<std::ptrdiff_t>(i);
+                count += std::find(declared_paths.begin(), previous, declared_paths[i]) == previous ? 1 : 0;
+            }
+            return count;
+        }
+
+        static constexpr std::size_t path_count = count_paths();
+
+        static consteval std::array<std::string_view, path_count> distinct_paths() {
+            std::array<std::string_view, path_count> paths{};
+            std::size_t count = 0;
+            for (const auto path: declared_paths) {
+                const auto end = paths.begin() + static_cast<std::ptrdiff_t>(count);
+                if (std::find(paths.begin(), end, path) == end) {
+                    paths[count++] = path;
+                }
+            }
+            return paths;
+        }
+
+        static constexpr auto paths = distinct_paths();
+
+        static consteval std::size_t path_id(const std::string_view path) {
+            return static_cast<std::size_t>(std::find(paths.begin(), paths.end(), path) - paths.begin());
+        }
+
+        static consteval auto parameter_table() {
+            std::array<http::PathParameters::Values, path_count> names{};
+            std::array<std::size_t, path_count> counts{};
+            for (std::size_t i = 0; i < path_count; ++i) {
+                names[i] = routing::parameter_names<http::PathParameters::Capacity>(paths[i]);
+                counts[i] = routing::count_parameters(paths[i]);
+            }
+            return std::pair{names, counts};
+        }
+
+        static constexpr auto parameters = parameter_table();
+
+        static constexpr std::size_t literal_count =
+                static_cast<std::size_t>(std::ranges::count_if(paths, std::not_fn(routing::is_parameterized)));
+
+        /// Distinct paths in table order: literal paths first, then patterns grouped by literal prefix.
+        static consteval std::array<std::size_t, path_count> path_order() {
+            std::array<std::size_t, path_count> order{};
+            std::size_t count = 0;
+            for (std::size_t path = 0; path < path_count; ++path) {
+                if (!routing::is_parameterized(paths[path])) {
+                    order[count++] = path;
+                }
+            }
+            // Insertion keeps patterns that share a prefix in declaration order, which is the order they are tried.
+            for (std::size_t path = 0; path < path_count; ++path) {
+                if (!routing::is_parameterized(paths[path])) {
+                    continue;
+                }
+                std::size_t i = count++;
+                for (; i > literal_count && routing::literal_prefix(paths[order[i - 1]]) >
+                                                    routing::literal_prefix(paths[path]);
+                     --i) {
+                    order[i] = order[i - 1];
+                }
+                order[i] = path;
+            }
+            return order;
+        }
+
+        static constexpr auto order = path_order();
+
+        static consteval std::array<std::string_view, literal_count> literal_paths() {
+            std::array<std::string_view, literal_count> literals{};
+            for (std::size_t i = 0; i < literal_count; ++i) {
+                literals[i] = paths[order[i]];
+            }
+            return literals;
+        }
+
+        static constexpr routing::PerfectHash<literal_count> index{literal_paths()};
+
+        static consteval std::size_t count_prefixes() {
+            std::size_t count = 0;
+            for (std::size_t i = literal_count; i < path_count; ++i) {
+                const auto prefix = routing::literal_prefix(paths[order[i]]);
+                count += i == literal_count || prefix != routing::literal_prefix(paths[order[i - 1]]) ? 1 : 0;
+            }
+            return count;
+        }
+
+        static constexpr std::size_t prefix_count = count_prefixes();
+
+        /// Each distinct prefix with the range of `order` holding the patterns that share it.
+        static consteval auto prefix_table() {
+            std::array<std::string_view, prefix_count> prefixes{};
+            std::array<std::size_t, prefix_count + 1> groups{};
+            std::size_t count = 0;
+            for (std::size_t i = literal_count; i < path_count; ++i) {
+                const auto prefix = routing::literal_prefix(paths[order[i]]);
+                if (count == 0 || prefix != prefixes[count - 1]) {
+                    prefixes[count] = prefix;
+                    groups[count++] = i;
+                }
+            }
+            groups[prefix_count] = path_count;
+            return std::pair{prefixes, groups};
+        }
+
+        static constexpr auto prefixes = prefix_table();
+        static constexpr routing::PerfectHash<prefix_count> prefix_index{prefixes.first};
+
+        static consteval auto count_prefix_lengths() {
+            std::array<std::size_t, prefix_count> lengths{};
+            for (std::size_t i = 0; i < prefix_count; ++i) {
+                lengths[i] = prefixes.first[i].size();
+            }
+            std::ranges::sort(lengths);
+            return static_cast<std::size_t>(std::ranges::unique(lengths).begin() - lengths.begin());
+        }
+
+        /// Distinct prefix lengths, longest first, so the most specific prefix is tried before a shorter one.
+        static consteval auto prefix_lengths() {
+            std::array<std::size_t, count_prefix_lengths()> lengths{};
+            std::size_t count = 0;
+            for (const auto prefix: prefixes.first) {
+                const auto end = lengths.begin() + static_cast<std::ptrdiff_t>(count);
+                if (std::find(lengths.begin(), end, prefix.size()) == end) {
+                    lengths[count++] = prefix.size();
+                }
+            }
+            std::ranges::sort(lengths, std::ranges::greater{});
+            return lengths;
+        }
+
+        static constexpr auto lengths = prefix_lengths();
+
+        /// Route serving each method on each distinct path; route_count where the path does not serve the method.
+        static consteval auto method_table() {
+            std::array<std::array<std::size_t, method_count>, path_count> table{};
+            for (auto &row: table) {
+                row.fill(route_count);
+            }
+            for (std::size_t i = 0; i < route_count; ++i) {
+                auto &route = table[path_id(declared_paths[i])][static_cast<std::size_t>(declared_methods[i])];
+                if (route != route_count) {
+                    throw std::invalid_argument("Route declared twice for the same method.");
+                }
+                route = i;
+            }
+            return table;
+        }
+
+        static constexpr auto methods = method_table();
+
+        static constexpr std::array<void (*)(http::RequestView &&, http::Responder &&), route_count> handlers{
+                &Routes::execute...};
+
+        [[nodiscard]] static constexpr std::string_view path_of(std::string_view target) noexcept {
+            if (const auto pos = target.find('?'); pos != std::string_view::npos) {
                 target = target.substr(0, pos);
             }
+            return target;
+        }
+
+        /// Distinct path a request path matches, with its captures stored in `values`; path_count if none does.
+        [[nodiscard]] static constexpr std::size_t locate(const std::string_view path,
+                                                          http::PathParameters::Values &values) noexcept {
+            if (const std::size_t literal = index.find(path); literal != index.npos) {
+                return order[literal];
+            }
+            for (const std::size_t length: lengths) {
+                if (path.size() < length) {
+                    continue;
+                }
+                const std::size_t prefix = prefix_index.find(path.substr(0, length));
+                if (prefix == prefix_index.npos) {
+                    continue;
+                }
+                for (std::size_t i = prefixes.second[prefix]; i < prefixes.second[prefix + 1]; ++i) {
+                    if (routing::match(paths[order[i]], path, values)) {
+                        return order[i];
+                    }
+                }
+            }
+            return path_count;
+        }
+
+        /// Declaration index of the route for a request, or route_count if there is none.
+        [[nodiscard]] static constexpr std::size_t resolve(const http::Method method,
+                                                           const std::string_view target) noexcept {
+            http::PathParameters::Values values{};
+            const std::size_t path = locate(path_of(target), values);
+            return path == path_count ? route_count : methods[path][static_cast<std::size_t>(method)];
+        }
 
-            const http::Method method = req.method;
-            const bool found = (((target == Routes::path && method == Routes::method) &&
-                                 (Routes::execute(std::forward<Req>(req), std::forward<Send>(send)), true)) ||
-                                ...);
-            if (!found) {
-                ControllerProvider::void_controller(std::forward<Req>(req), std::forward<Send>(send));
+        static void method_not_allowed(const std::size_t path, const http::RequestView &req, http::Responder &&send) {
+            http::Response res{http::Status::MethodNotAllowed, "प्रपञ्च — Prapancha: अनुचितम्। Non licet!",
+                               req.arena};
+            std::pmr::string allow(req.arena);
+            for (std::size_t method = 0; method < method_count; ++method) {
+                if (methods[path][method] != route_count) {
+                    allow.append(allow.empty() ? "" : ", ")
+                            .append(http::get_traits(static_cast<http::Method>(method)).name);
+                }
+            }
+            res.set_header("Allow", allow);
+            res.set_header("Content-Type", "text/html; charset=utf-8");
+            send(std::move(res));
+        }
+
+    public:
+        /// Body policy of the route a request will be dispatched to, known as soon as its header is parsed.
+        /// Unmatched requests admit no body at all. Transports check routed() before answering one with 413, so a
+        /// body sent to an unknown path or with the wrong method is never read and still gets its 404 or 405.
+        [[nodiscard]] static constexpr http::BodyLimit body_limit(const http::Method method,
+                                                                  const std::string_view target) noexcept {
+            const std::size_t route = resolve(method, target);
+            return route == route_count ? http::BodyLimit{0, false} : body_limits[route];
+        }
+
+        /// Whether a route serves `method` on `target`; dispatch answers anything else with 404 or 405.
+        [[nodiscard]] static constexpr bool routed(const http::Method method, const std::string_view target) noexcept {
+            return resolve(method, target) != route_count;
+        }
+
+        static void dispatch(http::RequestView &&req, http::Responder &&send) {
+            http::PathParameters::Values values{};
+            const std::size_t path = locate(path_of(req.target), values);
+            if (path == path_count) {
+                return ControllerProvider::void_controller(std::move(req), std::move(send));
+            }
+            const std::size_t route = methods[path][static_cast<std::size_t>(req.method)];
+            if (route == route_count) {
+                return method_not_allowed(path, req, std::move(send));
             }
+            req.parameters = {std::span(parameters.first[path]).first(parameters.second[path]), values};
+            handlers[route](std::move(req), std::move(send));
         }
     };
 
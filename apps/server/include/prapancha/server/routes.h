@@ -10,13 +10,19 @@
 
 namespace mehara::prapancha {
 
+    inline constexpr http::BodyLimit NoBody{0}; ///< Any request body is rejected with 413.
+    inline constexpr http::BodyLimit CredentialsBody{4 * 1024}; ///< A small JSON object of credentials.
+
     using AppRouter = Router<
-            Route<"/", http::Method::Get, ControllerProvider::root_controller>,
-            Route<"/api/v1/status", http::Method::Get, ControllerProvider::status_controller>,
-            Route<"/api/v1/register", http::Method::Post, ControllerProvider::Identity::registration_controller>,
-            Route<"/api/v1/deregister", http::Method::Delete, ControllerProvider::Identity::deregistration_controller>,
-            Route<"/api/v1/login", http::Method::Post, ControllerProvider::Identity::login_controller>,
-            Route<"/api/v1/logout", http::Method::Post, ControllerProvider::Identity::logout_controller>>;
+            Route<"/", http::Method::Get, ControllerProvider::root_controller, NoBody>,
+            Route<"/api/v1/status", http::Method::Get, ControllerProvider::status_controller, NoBody>,
+            Route<"/api/v1/register", http::Method::Post, ControllerProvider::Identity::registration_controller,
+                  CredentialsBody>,
+            Route<"/api/v1/deregister", http::Method::Delete, ControllerProvider::Identity::deregistration_controller,
+                  CredentialsBody>,
+            Route<"/api/v1/login", http::Method::Post, ControllerProvider::Identity::login_controller,
+                  CredentialsBody>,
+            Route<"/api/v1/logout", http::Method::Post, ControllerProvider::Identity::logout_controller, NoBody>>;
 
 } // namespace mehara::prapancha
 
@@ -5,56 +5,656 @@
 #ifndef PRAPANCHA_SERVER_SESSION_H_
 #define PRAPANCHA_SERVER_SESSION_H_
 
+#include <algorithm>
+#include <concepts>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
 #include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <variant>
+#include <vector>
 
+#include <sys/sendfile.h>
+#include <unistd.h>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/dispatch.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 
+#include <prapancha/server/arena.h>
 #include <prapancha/server/beast_adapter.h>
+#include <prapancha/server/configuration.h>
 #include <prapancha/server/http.h>
+#include <prapancha/server/http2_session.h>
+#include <prapancha/server/incoming.h>
 #include <prapancha/server/logger_registry.h>
+#include <prapancha/server/outgoing.h>
+#include <prapancha/server/responder.h>
+#include <prapancha/server/tls.h>
 
 namespace mehara::prapancha {
 
-    template<typename Router>
-    class Session : public std::enable_shared_from_this<Session<Router>> {
-        boost::beast::tcp_stream stream_;
+    /// @brief HTTP/1.1 connection with keep-alive and ordered request pipelining.
+    ///
+    /// Up to `pipeline_depth` requests are parsed ahead and dispatched concurrently. Each one owns a slot in a
+    /// per-connection ring, indexed by its sequence number. Responses may complete in any order, but they are
+    /// written strictly in request order, and every contiguous run of ready responses goes out in one gathered write.
+    /// In-memory bodies are serialized straight from the buffers the handler produced, file bodies are sent with
+    /// sendfile(2) and stream bodies are written chunk by chunk from a single per-response buffer.
+    ///
+    /// Bodies are admitted once the header is parsed: a Content-Length above the route's BodyLimit is answered with
+    /// 413 before a single body byte is read, and `Expect: 100-continue` is honoured. Streaming routes are dispatched
+    /// at that point and receive their body chunk by chunk through the request's BodyStream.
+    ///
+    /// Every slot owns an Arena. The parser, its header fields, the handler's response and any stream buffer are all
+    /// allocated from it, and the whole lifecycle is released in one step when the slot is recycled.
+    ///
+    /// A connection that opens with the HTTP/2 client preface, or asks to upgrade to h2c, is handed over to
+    /// Http2Session together with everything already buffered.
+    ///
+    /// Over a tls::Stream the session starts with the TLS handshake, and a client that negotiated h2 through ALPN
+    /// goes straight to Http2Session. File bodies still leave through sendfile(2) when the kernel encrypts the
+    /// connection, and are copied through OpenSSL otherwise.
+    template<typename Router, typename Transport = boost::beast::tcp_stream>
+    class Session : public std::enable_shared_from_this<Session<Router, Transport>> {
+        using RequestBody = boost::beast::http::vector_body<uint8_t, std::pmr::polymorphic_allocator<uint8_t>>;
+        using RequestParser = boost::beast::http::request_parser<RequestBody, std::pmr::polymorphic_allocator<char>>;
+        using StreamingParser = boost::beast::http::request_parser<boost::beast::http::buffer_body,
+                                                                   std::pmr::polymorphic_allocator<char>>;
+        using Sized = outgoing::Sized;
+        using File = outgoing::File;
+        using Stream = outgoing::Stream;
+
+        static constexpr bool secure = std::same_as<Transport, tls::Stream>;
+        static constexpr std::size_t sendfile_chunk_size = 1 << 20;
+        static constexpr std::size_t file_chunk_size = 64 * 1024;
+        static constexpr std::size_t detect_chunk_size = 4 * 1024;
+        static constexpr std::string_view switching_protocols =
+                "HTTP/1.1 101 Switching Protocols\r\nConnection: Upgrade\r\nUpgrade: h2c\r\n\r\n";
+
+        struct Slot {
+            // Declared first so it is destroyed last; everything below may hold memory from it.
+            Arena arena{configuration::Active->network.arena_size};
+            std::optional<RequestParser> parser;
+            std::optional<StreamingParser> streaming;
+            http::BodyStream body_stream;
+            std::uint8_t *chunk = nullptr;
+            outgoing::Message outgoing;
+            std::size_t pending = 0;
+            bool keep_alive = false;
+            bool receiving = false; ///< A streamed body is still being read into this slot.
+            bool responded = false; ///< The response went out before the streamed body finished.
+
+            void reset() {
+                outgoing.template emplace<std::monostate>();
+                streaming.reset();
+                parser.reset();
+                body_stream = {};
+                chunk = nullptr;
+                pending = 0;
+                receiving = false;
+                responded = false;
+                if (const std::size_t used = arena.reset(); used > 0) {
+                    Loggers::App().log_debug([&] {
+                        return std::format("प्रपञ्च — Prapancha: Request arena released {} of {} bytes.", used,
+                                           arena.capacity());
+                    });
+                }
+            }
+        };
+
+        Transport stream_;
         boost::beast::flat_buffer buffer_;
-        boost::beast::http::request<boost::beast::http::vector_body<uint8_t>> req_;
+        std::uint32_t depth_;
+        std::unique_ptr<Slot[]> ring_;
+        std::vector<boost::asio::const_buffer> gather_;
+        std::unique_ptr<char[]> file_chunk_;
+        std::uint64_t next_read_ = 0;
+        std::uint64_t next_write_ = 0;
+        std::uint64_t write_end_ = 0;
+        std::uint32_t served_ = 0;
+        bool reading_ = false;
+        bool writing_ = false;
+        bool draining_ = false;
+        bool zero_copy_ = !secure; ///< File bodies may bypass user space.
 
     public:
-        explicit Session(boost::asio::ip::tcp::socket &&socket) : stream_(std::move(socket)) {}
+        explicit Session(Transport &&stream) :
+            stream_(std::move(stream)), depth_(configuration::Active->network.pipeline_depth),
+            ring_(std::make_unique<Slot[]>(depth_)) {
+            gather_.reserve(static_cast<std::size_t>(depth_) * 2);
+        }
 
         void run() {
-            boost::beast::http::async_read(
-                    stream_, buffer_, req_,
-                    boost::beast::bind_front_handler(&Session::on_read, this->shared_from_this()));
+            if constexpr (secure) {
+                do_handshake();
+            } else {
+                do_detect();
+            }
         }
 
     private:
-        void on_read(boost::beast::error_code ec, std::size_t) {
+        [[nodiscard]] Slot &slot(const std::uint64_t sequence) noexcept { return ring_[sequence % depth_]; }
+
+        [[nodiscard]] bool idle() const noexcept { return !reading_ && !writing_ && next_write_ == next_read_; }
+
+        void do_handshake() {
+            if (stream_.native_handle() == nullptr) {
+                return;
+            }
+            stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            stream_.async_handshake([self = this->shared_from_this(), started = std::chrono::steady_clock::now()](
+                                            boost::beast::error_code ec, std::size_t) {
+                tls::Context::record(self->stream_.native_handle(), std::chrono::steady_clock::now() - started, !ec);
+                if (ec) {
+                    Loggers::App().log_debug([&] {
+                        return std::format("प्रपञ्च — Prapancha: TLS handshake failed [{}]: {}", ec.value(),
+                                           ec.message());
+                    });
+                    return;
+                }
+                self->zero_copy_ = self->stream_.zero_copy();
+                if (self->stream_.alpn() == "h2") {
+                    return std::make_shared<Http2Session<Router, Transport>>(std::move(self->stream_),
+                                                                             std::move(self->buffer_))
+                            ->run();
+                }
+                self->do_read();
+            });
+        }
+
+        /// Reads until the connection either opens with the HTTP/2 client preface or diverges from it. Bytes read here
+        /// stay in the buffer for whichever protocol takes over.
+        void do_detect() {
+            stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            stream_.async_read_some(buffer_.prepare(detect_chunk_size),
+                                    boost::beast::bind_front_handler(&Session::on_detect, this->shared_from_this()));
+        }
+
+        void on_detect(boost::beast::error_code ec, const std::size_t bytes_transferred) {
             if (ec) {
                 return;
             }
-            if (req_.version() != 11) {
-                Loggers::App().log_info("प्रपञ्च — Prapancha: Request version {} not supported.", req_.version());
+            buffer_.commit(bytes_transferred);
+            constexpr auto preface = Http2Session<Router>::client_preface;
+            const std::string_view received(static_cast<const char *>(buffer_.data().data()),
+                                            std::min(buffer_.size(), preface.size()));
+            if (!preface.starts_with(received)) {
+                return do_read();
+            }
+            if (received.size() < preface.size()) {
+                return do_detect();
+            }
+            std::make_shared<Http2Session<Router, Transport>>(std::move(stream_), std::move(buffer_))->run();
+        }
+
+        [[nodiscard]] static bool is_h2c_upgrade(const http::RequestView &request) {
+            // h2c is cleartext by definition; over TLS, HTTP/2 is only reached through ALPN.
+            if constexpr (secure) {
+                return false;
+            }
+            const auto upgrade = request.header(boost::beast::http::field::upgrade);
+            return upgrade && boost::beast::iequals(*upgrade, "h2c") && request.header("HTTP2-Settings");
+        }
+
+        /// Answers an `Upgrade: h2c` request with 101 and replays it as stream 1 of a new Http2Session.
+        void upgrade(Slot &current) {
+            auto request = http::from_beast(current.parser->get(), &current.arena).to_owned();
+            auto settings = request.header("HTTP2-Settings").value_or(std::string{});
+            current.reset();
+            stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            boost::asio::async_write(
+                    stream_, boost::asio::buffer(switching_protocols),
+                    [self = this->shared_from_this(), request = std::move(request),
+                     settings = std::move(settings)](boost::beast::error_code ec, std::size_t) mutable {
+                        if (ec) {
+                            return;
+                        }
+                        std::make_shared<Http2Session<Router, Transport>>(std::move(self->stream_),
+                                                                          std::move(self->buffer_))
+                                ->upgrade(std::move(request), settings);
+                    });
+        }
+
+        void do_read() {
+            if (reading_ || draining_ || next_read_ - next_write_ == depth_) {
                 return;
             }
-            auto request = http::from_beast(req_);
-            auto send = [self = this->shared_from_this()](http::Response &&response) {
-                auto beast_response = std::make_shared<boost::beast::http::response<boost::beast::http::string_body>>(
-                        http::to_beast(std::move(response)));
-                boost::beast::http::async_write(self->stream_, *beast_response,
-                                                [self, beast_response](boost::beast::error_code ec, std::size_t) {
-                                                    if (!ec) {
-                                                        boost::system::error_code ignored_ec;
-                                                        self->stream_.socket().shutdown(
-                                                                boost::asio::ip::tcp::socket::shutdown_send,
-                                                                ignored_ec);
-                                                    }
-                                                });
+            // Beast parsers are single-use; re-emplacing keeps the storage inline across requests.
+            auto &next = slot(next_read_);
+            const std::pmr::polymorphic_allocator<uint8_t> alloc(&next.arena);
+            auto &parser = next.parser.emplace(std::piecewise_construct, std::make_tuple(alloc),
+                                               std::make_tuple(std::pmr::polymorphic_allocator<char>(alloc)));
+            reading_ = true;
+            stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            boost::beast::http::async_read_header(
+                    stream_, buffer_, parser,
+                    boost::beast::bind_front_handler(&Session::on_header, this->shared_from_this()));
+        }
+
+        void on_header(boost::beast::error_code ec, std::size_t) {
+            if (ec == boost::beast::http::error::end_of_stream) {
+                reading_ = false;
+                draining_ = true;
+                if (idle()) {
+                    do_close();
+                }
+                return;
+            }
+            if (ec) {
+                reading_ = false;
+                return;
+            }
+            const std::uint64_t sequence = next_read_;
+            auto &current = slot(sequence);
+            auto &parser = *current.parser;
+            auto &req = parser.get();
+            if (req.version() != 11) {
+                Loggers::App().log_info("प्रपञ्च — Prapancha: Request version {} not supported.", req.version());
+                reading_ = false;
+                current.reset();
+                draining_ = true;
+                if (idle()) {
+                    do_close();
+                }
+                return;
+            }
+            const auto limit = Router::body_limit(http::from_beast(req.method()), req.target());
+            switch (incoming::admit(parser, limit)) {
+                case incoming::Admission::Reject:
+                    return reject(sequence);
+                case incoming::Admission::Continue:
+                    // Interim responses cannot overtake final ones, so only a request with nothing queued ahead of it
+                    // is told to continue. The client sends the body anyway once its own wait expires.
+                    if (sequence == next_write_ && !writing_) {
+                        return do_continue(sequence, limit);
+                    }
+                    break;
+                case incoming::Admission::Accept:
+                    break;
+            }
+            read_body(sequence, limit);
+        }
+
+        void do_continue(const std::uint64_t sequence, const http::BodyLimit limit) {
+            writing_ = true;
+            boost::asio::async_write(stream_, boost::asio::buffer(incoming::continue_response),
+                                     [self = this->shared_from_this(), sequence, limit](boost::beast::error_code ec,
+                                                                                        std::size_t) {
+                                         self->writing_ = false;
+                                         if (ec) {
+                                             self->reading_ = false;
+                                             return;
+                                         }
+                                         self->read_body(sequence, limit);
+                                         self->do_write();
+                                     });
+        }
+
+        void read_body(const std::uint64_t sequence, const http::BodyLimit limit) {
+            auto &current = slot(sequence);
+            // An h2c upgrade is buffered whatever its route, since it is replayed whole as the first HTTP/2 stream.
+            if (limit.streaming && !is_h2c_upgrade(http::from_beast(current.parser->get(), &current.arena))) {
+                return start_streaming(sequence);
+            }
+            stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            boost::beast::http::async_read(stream_, buffer_, *current.parser,
+                                           boost::beast::bind_front_handler(&Session::on_read,
+                                                                            this->shared_from_this()));
+        }
+
+        void on_read(boost::beast::error_code ec, std::size_t) {
+            const std::uint64_t sequence = next_read_;
+            if (ec == boost::beast::http::error::body_limit) {
+                return reject(sequence);
+            }
+            reading_ = false;
+            if (ec) {
+                return;
+            }
+            auto &current = slot(sequence);
+            auto &req = current.parser->get();
+            // Only a request with nothing ahead of it may switch protocols; later pipelined requests are not reordered.
+            if (sequence == next_write_ && is_h2c_upgrade(http::from_beast(req, &current.arena))) {
+                return upgrade(current);
+            }
+            ++next_read_;
+            current.keep_alive =
+                    req.keep_alive() && ++served_ < configuration::Active->network.max_requests_per_connection;
+            draining_ = !current.keep_alive;
+            // The view borrows from the slot's parser, which is only released once this request's response is written.
+            Router::dispatch(http::from_beast(req, &current.arena), responder(sequence));
+            do_read();
+        }
+
+        [[nodiscard]] http::Responder responder(const std::uint64_t sequence) {
+            return [self = this->shared_from_this(), sequence](http::Response &&response) {
+                self->on_response(sequence, std::move(response));
             };
-            Router::dispatch(std::move(request), std::move(send));
+        }
+
+        /// Answers 413 in place of a request whose body was refused, or 404/405 when no route would have taken it.
+        /// The unread body makes the connection unusable.
+        void reject(const std::uint64_t sequence) {
+            reading_ = false;
+            ++next_read_;
+            auto &current = slot(sequence);
+            current.keep_alive = false;
+            draining_ = true;
+            const auto &req = current.parser->get();
+            if (!Router::routed(http::from_beast(req.method()), req.target())) {
+                return Router::dispatch(http::from_beast(req.base(), &current.arena), responder(sequence));
+            }
+            on_response(sequence, incoming::too_large(&current.arena));
+        }
+
+        /// Dispatches a streaming route on its header alone, then feeds it the body one arena chunk at a time. Reading
+        /// stays with this request until its body ends, even if the response is written first.
+        void start_streaming(const std::uint64_t sequence) {
+            ++next_read_;
+            auto &current = slot(sequence);
+            auto &parser = current.streaming.emplace(std::move(*current.parser));
+            current.keep_alive =
+                    parser.get().keep_alive() && ++served_ < configuration::Active->network.max_requests_per_connection;
+            draining_ = !current.keep_alive;
+            current.receiving = true;
+            current.chunk = static_cast<std::uint8_t *>(current.arena.allocate(http::BodyLimit::ChunkSize, 1));
+            auto request = http::from_beast(parser.get().base(), &current.arena);
+            request.stream = &current.body_stream;
+            Router::dispatch(std::move(request), responder(sequence));
+            do_read_chunk(sequence);
+        }
+
+        void do_read_chunk(const std::uint64_t sequence) {
+            auto &current = slot(sequence);
+            if (current.streaming->is_done()) {
+                current.body_stream.deliver({}, true);
+                return end_streaming(current);
+            }
+            auto &body = current.streaming->get().body();
+            body.data = current.chunk;
+            body.size = http::BodyLimit::ChunkSize;
+            stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            boost::beast::http::async_read_some(stream_, buffer_, *current.streaming,
+                                                [self = this->shared_from_this(), sequence](
+                                                        boost::beast::error_code ec, std::size_t) {
+                                                    self->on_read_chunk(sequence, ec);
+                                                });
+        }
+
+        void on_read_chunk(const std::uint64_t sequence, boost::beast::error_code ec) {
+            if (ec == boost::beast::http::error::need_buffer) {
+                ec = {};
+            }
+            if (ec) {
+                // The handler owns the response already, so a body cut short or over the limit ends the connection.
+                // Dropping the sink releases whatever the handler captured in it.
+                slot(sequence).body_stream = {};
+                reading_ = false;
+                draining_ = true;
+                return do_close();
+            }
+            auto &current = slot(sequence);
+            const std::size_t produced = http::BodyLimit::ChunkSize - current.streaming->get().body().size;
+            const bool last = current.streaming->is_done();
+            if (produced > 0 || last) {
+                current.body_stream.deliver({current.chunk, produced}, last);
+            }
+            if (!last) {
+                return do_read_chunk(sequence);
+            }
+            end_streaming(current);
+        }
+
+        void end_streaming(Slot &current) {
+            current.receiving = false;
+            reading_ = false;
+            if (current.responded) {
+                current.reset();
+            }
+            resume();
+        }
+
+        void on_response(const std::uint64_t sequence, http::Response &&response) {
+            // Handlers may complete on any thread; hop back onto the connection's executor before touching the ring.
+            boost::asio::dispatch(stream_.get_executor(), [self = this->shared_from_this(), sequence,
+                                                           response = std::move(response)]() mutable {
+                auto &ready = self->slot(sequence);
+                outgoing::prepare(ready.outgoing, ready.arena, std::move(response), ready.keep_alive);
+                self->do_write();
+            });
+        }
+
+        void do_write() {
+            if (writing_) {
+                return;
+            }
+            gather_.clear();
+            write_end_ = next_write_;
+            while (write_end_ < next_read_) {
+                auto &ready = slot(write_end_);
+                if (std::holds_alternative<std::monostate>(ready.outgoing)) {
+                    break;
+                }
+                if (auto *stream = std::get_if<Stream>(&ready.outgoing)) {
+                    if (gather_.empty()) {
+                        return do_stream(*stream);
+                    }
+                    break;
+                }
+                boost::beast::error_code ec;
+                auto gather = [&](auto &serializer) {
+                    serializer.next(ec, [&](boost::beast::error_code &, const auto &buffers) {
+                        ready.pending = boost::asio::buffer_size(buffers);
+                        for (auto it = boost::asio::buffer_sequence_begin(buffers);
+                             it != boost::asio::buffer_sequence_end(buffers); ++it) {
+                            gather_.emplace_back(*it);
+                        }
+                    });
+                };
+                auto *file = std::get_if<File>(&ready.outgoing);
+                if (file) {
+                    gather(file->serializer);
+                } else {
+                    gather(std::get<Sized>(ready.outgoing).serializer);
+                }
+                if (ec) {
+                    return;
+                }
+                ++write_end_;
+                // A file body follows its header directly on the socket, so it always ends the gathered run.
+                if (!ready.keep_alive || file) {
+                    break;
+                }
+            }
+            if (gather_.empty()) {
+                return;
+            }
+            writing_ = true;
+            stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            boost::asio::async_write(stream_, gather_,
+                                     boost::beast::bind_front_handler(&Session::on_write, this->shared_from_this()));
+        }
+
+        void on_write(boost::beast::error_code ec, std::size_t) {
+            writing_ = false;
+            if (ec) {
+                return;
+            }
+            while (next_write_ < write_end_) {
+                auto &written = slot(next_write_);
+                if (auto *file = std::get_if<File>(&written.outgoing)) {
+                    file->serializer.consume(written.pending);
+                    writing_ = true;
+                    return do_sendfile(*file);
+                }
+                std::get<Sized>(written.outgoing).serializer.consume(written.pending);
+                if (!complete()) {
+                    return;
+                }
+            }
+            resume();
+        }
+
+        void do_sendfile(File &file) {
+            if (!zero_copy_) {
+                return do_copy_file(file);
+            }
+            auto &socket = stream_.socket();
+            boost::beast::error_code ec;
+            socket.native_non_blocking(true, ec);
+            while (!ec && file.remaining > 0) {
+                auto offset = static_cast<off_t>(file.offset);
+                const ssize_t sent = ::sendfile(socket.native_handle(), file.file.native_handle(), &offset,
+                                                std::min<std::uint64_t>(file.remaining, sendfile_chunk_size));
+                if (sent > 0) {
+                    file.offset += static_cast<std::uint64_t>(sent);
+                    file.remaining -= static_cast<std::uint64_t>(sent);
+                } else if (sent < 0 && errno == EINTR) {
+                    continue;
+                } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    socket.async_wait(boost::asio::socket_base::wait_write,
+                                      [self = this->shared_from_this(), &file](boost::beast::error_code wait_ec) {
+                                          if (wait_ec) {
+                                              self->writing_ = false;
+                                              return;
+                                          }
+                                          self->do_sendfile(file);
+                                      });
+                    return;
+                } else {
+                    // A short file leaves the advertised Content-Length unmet; the connection cannot be reused.
+                    ec = sent < 0 ? boost::beast::error_code(errno, boost::system::system_category())
+                                  : boost::beast::error_code(boost::asio::error::eof);
+                }
+            }
+            writing_ = false;
+            if (ec) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: sendfile failed [{}]: {}", ec.value(), ec.message());
+                return do_close();
+            }
+            if (complete()) {
+                resume();
+            }
+        }
+
+        /// Without kernel TLS the file has to pass through OpenSSL, so it is read and written one chunk at a time.
+        void do_copy_file(File &file) {
+            if (file.remaining == 0) {
+                writing_ = false;
+                if (complete()) {
+                    resume();
+                }
+                return;
+            }
+            if (!file_chunk_) {
+                file_chunk_ = std::make_unique_for_overwrite<char[]>(file_chunk_size);
+            }
+            const std::size_t wanted = std::min<std::uint64_t>(file.remaining, file_chunk_size);
+            ssize_t read = 0;
+            do {
+                read = ::pread(file.file.native_handle(), file_chunk_.get(), wanted, static_cast<off_t>(file.offset));
+            } while (read < 0 && errno == EINTR);
+            if (read <= 0) {
+                // A short file leaves the advertised Content-Length unmet; the connection cannot be reused.
+                writing_ = false;
+                Loggers::App().log_error("प्रपञ्च — Prapancha: File read failed [{}]: {}", errno,
+                                         read < 0 ? std::strerror(errno) : "unexpected end of file");
+                return do_close();
+            }
+            file.offset += static_cast<std::uint64_t>(read);
+            file.remaining -= static_cast<std::uint64_t>(read);
+            stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            boost::asio::async_write(
+                    stream_, boost::asio::buffer(file_chunk_.get(), static_cast<std::size_t>(read)),
+                    [self = this->shared_from_this(), &file](boost::beast::error_code ec, std::size_t) {
+                        if (ec) {
+                            self->writing_ = false;
+                            return;
+                        }
+                        self->do_copy_file(file);
+                    });
+        }
+
+        void do_stream(Stream &stream) {
+            writing_ = true;
+            stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            boost::beast::http::async_write_header(
+                    stream_, stream.serializer,
+                    [self = this->shared_from_this(), &stream](boost::beast::error_code ec, std::size_t) {
+                        if (ec) {
+                            self->writing_ = false;
+                            return;
+                        }
+                        self->do_stream_chunk(stream);
+                    });
+        }
+
+        void do_stream_chunk(Stream &stream) {
+            stream.next_chunk();
+            stream_.expires_after(std::chrono::seconds(configuration::Active->network.keep_alive_timeout));
+            boost::beast::http::async_write(
+                    stream_, stream.serializer,
+                    [self = this->shared_from_this(), &stream](boost::beast::error_code ec, std::size_t) {
+                        if (ec == boost::beast::http::error::need_buffer) {
+                            ec = {};
+                        }
+                        if (ec) {
+                            self->writing_ = false;
+                            return;
+                        }
+                        if (!stream.serializer.is_done()) {
+                            return self->do_stream_chunk(stream);
+                        }
+                        self->writing_ = false;
+                        if (self->complete()) {
+                            self->resume();
+                        }
+                    });
+        }
+
+        /// Releases the slot at the head of the ring. Returns false once the connection has been closed.
+        bool complete() {
+            auto &written = slot(next_write_);
+            const bool keep_alive = written.keep_alive;
+            // A slot still streaming its body keeps its parser and arena; end_streaming() recycles it.
+            if (written.receiving) {
+                written.responded = true;
+            } else {
+                written.reset();
+            }
+            ++next_write_;
+            if (!keep_alive) {
+                do_close();
+                return false;
+            }
+            return true;
+        }
+
+        void resume() {
+            if (draining_ && idle()) {
+                return do_close();
+            }
+            do_read();
+            do_write();
+        }
+
+        void do_close() {
+            if constexpr (secure) {
+                stream_.close_notify();
+            }
+            boost::system::error_code ignored_ec;
+            stream_.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_send, ignored_ec);
         }
     };
 
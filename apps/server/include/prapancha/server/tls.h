@@ -0,0 +1,218 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_TLS_H_
+#define PRAPANCHA_SERVER_TLS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/ssl/error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core/error.hpp>
+
+#include <prapancha/server/configuration.h>
+
+/// @brief TLS termination for the Asio transport.
+namespace mehara::prapancha::tls {
+
+    /// Context Class
+    ///
+    /// Server-wide OpenSSL context shared by every listener, so session tickets issued on one shard resume on any
+    /// other. Kernel TLS is requested for every connection; OpenSSL hands the record layer to the kernel once the
+    /// handshake has settled on a cipher the kernel supports, and keeps it in user space otherwise. Resumption is
+    /// served both from stateless tickets and from a bounded server-side session cache. ALPN offers h2 ahead of
+    /// http/1.1.
+    class Context {
+    public:
+        /// Process-wide handshake totals. Rates follow from sampling them over time.
+        struct Statistics {
+            std::atomic<std::uint64_t> handshakes{0};
+            std::atomic<std::uint64_t> resumed{0};
+            std::atomic<std::uint64_t> failures{0};
+            std::atomic<std::uint64_t> ktls_send{0}; ///< Connections whose writes are encrypted by the kernel.
+            std::atomic<std::uint64_t> ktls_receive{0}; ///< Connections whose reads are decrypted by the kernel.
+            std::atomic<std::uint64_t> handshake_nanoseconds{0};
+        };
+
+    private:
+        std::unique_ptr<SSL_CTX, decltype(&SSL_CTX_free)> context_{nullptr, SSL_CTX_free};
+
+    public:
+        /// Loads the certificate chain and private key named in the network configuration. ready() is false if
+        /// either could not be used.
+        explicit Context(const configuration::Configuration::Network &network);
+
+        Context(const Context &) = delete;
+        Context &operator=(const Context &) = delete;
+
+        [[nodiscard]] bool ready() const noexcept { return context_ != nullptr; }
+
+        [[nodiscard]] SSL_CTX *native() const noexcept { return context_.get(); }
+
+        /// Records a finished handshake and logs how it was negotiated.
+        static void record(const SSL *ssl, std::chrono::steady_clock::duration elapsed, bool succeeded) noexcept;
+
+        [[nodiscard]] static Statistics &statistics() noexcept;
+    };
+
+    /// Stream Class
+    ///
+    /// AsyncReadStream / AsyncWriteStream over a TCP socket whose SSL object is bound to the socket descriptor itself
+    /// rather than to a memory BIO, which is what lets OpenSSL enable kernel TLS. Reads and writes call SSL_read_ex /
+    /// SSL_write_ex non-blocking and wait for socket readiness when OpenSSL asks for it. With kernel TLS active those
+    /// calls are plain syscalls and sendfile(2) on socket() sends the file encrypted.
+    ///
+    /// Like beast::tcp_stream, a deadline set with expires_after() closes the socket when it passes. The state lives
+    /// behind a shared pointer so the stream can be handed from Session to Http2Session after ALPN.
+    class Stream {
+        struct State {
+            boost::asio::ip::tcp::socket socket;
+            boost::asio::steady_timer timer;
+            std::unique_ptr<SSL, decltype(&SSL_free)> ssl;
+            std::vector<std::uint8_t> scratch;
+
+            State(boost::asio::ip::tcp::socket &&socket, SSL *ssl) :
+                socket(std::move(socket)), timer(this->socket.get_executor()), ssl(ssl, SSL_free) {}
+        };
+
+        static constexpr std::size_t record_size = 16 * 1024; ///< Largest TLS plaintext record.
+
+        std::shared_ptr<State> state_;
+
+        /// Runs one non-blocking OpenSSL call to completion, parking on socket readiness in between. An immediate
+        /// result is posted rather than invoked inline, as Asio requires of initiating functions.
+        template<typename Call>
+        struct Drive {
+            std::shared_ptr<State> state;
+            Call call;
+            bool settled = false;
+            boost::system::error_code result;
+            std::size_t transferred = 0;
+            bool started = false;
+
+            template<typename Self>
+            void operator()(Self &self, const boost::system::error_code ec = {}) {
+                const bool waited = started;
+                started = true;
+                if (settled) {
+                    return self.complete(result, transferred);
+                }
+                if (ec) {
+                    return self.complete(ec, 0);
+                }
+                ERR_clear_error();
+                const int rc = call(state->ssl.get(), &transferred);
+                if (rc != 1) {
+                    switch (SSL_get_error(state->ssl.get(), rc)) {
+                        case SSL_ERROR_WANT_READ:
+                            return state->socket.async_wait(boost::asio::socket_base::wait_read, std::move(self));
+                        case SSL_ERROR_WANT_WRITE:
+                            return state->socket.async_wait(boost::asio::socket_base::wait_write, std::move(self));
+                        case SSL_ERROR_ZERO_RETURN:
+                            result = boost::asio::error::eof;
+                            break;
+                        case SSL_ERROR_SYSCALL:
+                            result = errno != 0 ? boost::system::error_code(errno, boost::system::system_category())
+                                                : boost::system::error_code(boost::asio::error::eof);
+                            break;
+                        default:
+                            result = boost::system::error_code(static_cast<int>(ERR_get_error()),
+                                                               boost::asio::error::get_ssl_category());
+                            break;
+                    }
+                    transferred = 0;
+                }
+                if (waited) {
+                    return self.complete(result, transferred);
+                }
+                settled = true;
+                boost::asio::post(state->socket.get_executor(), std::move(self));
+            }
+        };
+
+        template<typename Call, typename Token>
+        auto drive(Call call, Token &&token) {
+            return boost::asio::async_compose<Token, void(boost::system::error_code, std::size_t)>(
+                    Drive<Call>{state_, std::move(call)}, token, state_->socket);
+        }
+
+    public:
+        using executor_type = boost::asio::ip::tcp::socket::executor_type;
+
+        Stream(boost::asio::ip::tcp::socket &&socket, const Context &context);
+
+        [[nodiscard]] executor_type get_executor() noexcept { return state_->socket.get_executor(); }
+
+        [[nodiscard]] boost::asio::ip::tcp::socket &socket() noexcept { return state_->socket; }
+
+        [[nodiscard]] SSL *native_handle() const noexcept { return state_->ssl.get(); }
+
+        /// True once the kernel encrypts writes, so file bodies may go out with sendfile(2).
+        [[nodiscard]] bool zero_copy() const noexcept;
+
+        /// Protocol selected through ALPN, empty if the client offered none.
+        [[nodiscard]] std::string_view alpn() const noexcept;
+
+        void expires_after(std::chrono::steady_clock::duration expiry);
+
+        void expires_never();
+
+        /// Sends close_notify if the socket accepts it right away; never waits for the peer's.
+        void close_notify() noexcept;
+
+        template<typename Token>
+        auto async_handshake(Token &&token) {
+            return drive([](SSL *ssl, std::size_t *) { return SSL_do_handshake(ssl); }, std::forward<Token>(token));
+        }
+
+        template<typename MutableBuffers, typename Token>
+        auto async_read_some(const MutableBuffers &buffers, Token &&token) {
+            const boost::asio::mutable_buffer buffer = *boost::asio::buffer_sequence_begin(buffers);
+            return drive(
+                    [buffer](SSL *ssl, std::size_t *read) {
+                        return SSL_read_ex(ssl, buffer.data(), buffer.size(), read);
+                    },
+                    std::forward<Token>(token));
+        }
+
+        /// Gathered buffers are coalesced into one record-sized write so small headers do not become records of
+        /// their own. The copy is kept until the write completes, since OpenSSL retries require the same bytes.
+        template<typename ConstBuffers, typename Token>
+        auto async_write_some(const ConstBuffers &buffers, Token &&token) {
+            boost::asio::const_buffer buffer = *boost::asio::buffer_sequence_begin(buffers);
+            if (std::next(boost::asio::buffer_sequence_begin(buffers)) != boost::asio::buffer_sequence_end(buffers) &&
+                buffer.size() < record_size) {
+                auto &scratch = state_->scratch;
+                scratch.resize(std::min(boost::asio::buffer_size(buffers), record_size));
+                scratch.resize(boost::asio::buffer_copy(boost::asio::buffer(scratch), buffers));
+                buffer = boost::asio::buffer(scratch);
+            }
+            return drive(
+                    [buffer](SSL *ssl, std::size_t *written) {
+                        return SSL_write_ex(ssl, buffer.data(), buffer.size(), written);
+                    },
+                    std::forward<Token>(token));
+        }
+    };
+
+} // namespace mehara::prapancha::tls
+
+#endif // PRAPANCHA_SERVER_TLS_H_
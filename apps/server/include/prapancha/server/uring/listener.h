@@ -0,0 +1,98 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_URING_LISTENER_H_
+#define PRAPANCHA_SERVER_URING_LISTENER_H_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stop_token>
+
+#include <unistd.h>
+
+#include <liburing.h>
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include <prapancha/server/logger_registry.h>
+#include <prapancha/server/uring/ring.h>
+#include <prapancha/server/uring/session.h>
+
+namespace mehara::prapancha::uring {
+
+    /// @brief Per-thread acceptor and event loop for the io_uring transport.
+    ///
+    /// Owns its thread's Ring and an SO_REUSEPORT listening socket. A single multishot accept keeps producing
+    /// connections straight into the ring's registered file table, so accepting never costs a submission per client.
+    /// Must be constructed on the thread that will call run().
+    template<typename Router>
+    class Listener {
+        // Declared first so it is destroyed last; sessions and the accept hold completions registered on it.
+        Ring ring_;
+        int socket_ = -1;
+        Operation<Listener> accept_{*this, &Listener::on_accept};
+        Operation<Listener> backoff_{*this, &Listener::on_backoff};
+        __kernel_timespec backoff_interval_{.tv_sec = 0, .tv_nsec = 100'000'000};
+        typename Session<Router>::Registry sessions_;
+
+    public:
+        explicit Listener(const boost::asio::ip::tcp::endpoint &endpoint) {
+            if (!ring_.ready()) {
+                return;
+            }
+            socket_ = open_listener(endpoint);
+            if (socket_ >= 0) {
+                do_accept();
+            }
+        }
+
+        ~Listener() {
+            sessions_.clear();
+            if (socket_ >= 0) {
+                ::close(socket_);
+            }
+        }
+
+        Listener(const Listener &) = delete;
+        Listener &operator=(const Listener &) = delete;
+
+        [[nodiscard]] bool ready() const noexcept { return socket_ >= 0; }
+
+        void run(const std::stop_token token) { ring_.run(token); }
+
+        /// Interrupts run() from any thread so it can observe a stop request.
+        void wake() noexcept { ring_.wake(); }
+
+    private:
+        void do_accept() {
+            io_uring_prep_multishot_accept_direct(ring_.prepare(accept_), socket_, nullptr, nullptr, 0);
+        }
+
+        void on_accept(const std::int32_t result, const std::uint32_t flags) {
+            if (result >= 0) {
+                auto session = std::make_shared<Session<Router>>(ring_, sessions_, result);
+                sessions_.emplace(session.get(), session);
+                session->run();
+            } else if (result != -ECANCELED) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: Accept failed [{}]: {}", -result,
+                                         std::strerror(-result));
+            }
+            if (flags & IORING_CQE_F_MORE) {
+                return;
+            }
+            // The multishot accept has ended. A full file table ends it too, so give connections time to close first.
+            if (result == -ENFILE || result == -EMFILE) {
+                return io_uring_prep_timeout(ring_.prepare(backoff_), &backoff_interval_, 0, 0);
+            }
+            do_accept();
+        }
+
+        void on_backoff(std::int32_t, std::uint32_t) { do_accept(); }
+    };
+
+} // namespace mehara::prapancha::uring
+
+#endif // PRAPANCHA_SERVER_URING_LISTENER_H_
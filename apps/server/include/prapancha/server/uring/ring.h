@@ -0,0 +1,116 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_URING_RING_H_
+#define PRAPANCHA_SERVER_URING_RING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include <liburing.h>
+
+#include <boost/asio/ip/tcp.hpp>
+
+namespace mehara::prapancha::uring {
+
+    /// @brief Target of a completion; every submission carries a pointer to one as its user data.
+    class Completion {
+    public:
+        virtual void complete(std::int32_t result, std::uint32_t flags) = 0;
+
+    protected:
+        ~Completion() = default;
+    };
+
+    /// @brief Routes a completion to a member function of its owner.
+    template<typename Owner>
+    class Operation final : public Completion {
+        using Handler = void (Owner::*)(std::int32_t, std::uint32_t);
+
+        Owner &owner_;
+        Handler handler_;
+
+    public:
+        Operation(Owner &owner, const Handler handler) noexcept : owner_(owner), handler_(handler) {}
+
+        void complete(const std::int32_t result, const std::uint32_t flags) override {
+            (owner_.*handler_)(result, flags);
+        }
+    };
+
+    /// Ring Class
+    ///
+    /// One io_uring instance owned and driven by a single thread. Accepted sockets live in a sparse registered file
+    /// table, reads draw from a provided buffer ring so no memory is pinned to idle connections, and work posted from
+    /// other threads is woken through an eventfd read that stays armed on the ring itself.
+    class Ring {
+    public:
+        static constexpr unsigned entries = 4096; ///< Submission queue depth.
+        static constexpr unsigned registered_files = 16384; ///< Direct descriptors available to accepted sockets.
+        static constexpr unsigned buffer_count = 1024; ///< Provided receive buffers; must be a power of two.
+        static constexpr unsigned buffer_size = 8 * 1024; ///< Bytes per provided receive buffer.
+        static constexpr std::uint16_t buffer_group = 0; ///< Buffer group id used with IOSQE_BUFFER_SELECT.
+
+    private:
+        io_uring ring_{};
+        io_uring_buf_ring *buffers_ = nullptr;
+        std::unique_ptr<char[]> storage_;
+        int event_fd_ = -1;
+        std::uint64_t wakeup_value_ = 0;
+        Operation<Ring> wakeup_{*this, &Ring::on_wakeup};
+        std::thread::id owner_;
+        std::mutex posted_mutex_;
+        std::vector<std::move_only_function<void()>> posted_;
+        std::vector<std::move_only_function<void()>> running_;
+        bool initialized_ = false;
+        bool ready_ = false;
+
+    public:
+        Ring();
+        ~Ring();
+
+        Ring(const Ring &) = delete;
+        Ring &operator=(const Ring &) = delete;
+
+        /// Probes whether the running kernel offers everything this transport relies on.
+        [[nodiscard]] static bool supported() noexcept;
+
+        [[nodiscard]] bool ready() const noexcept;
+
+        /// Returns a submission entry whose completion is delivered to `completion`.
+        [[nodiscard]] io_uring_sqe *prepare(Completion &completion);
+
+        /// Bytes a buffer-select receive landed in, identified by its completion flags.
+        [[nodiscard]] std::span<const char> buffer(std::uint32_t flags, std::int32_t length) const noexcept;
+
+        /// Hands a provided buffer back to the kernel once its bytes have been consumed.
+        void release(std::uint32_t flags) noexcept;
+
+        /// Runs `task` inline on the ring's thread, or queues it and wakes the ring from any other thread.
+        void dispatch(std::move_only_function<void()> &&task);
+
+        void wake() noexcept;
+
+        /// Submits and reaps completions until `token` is stopped. Must be called from the thread that built the ring.
+        void run(std::stop_token token);
+
+    private:
+        void arm_wakeup();
+
+        void on_wakeup(std::int32_t result, std::uint32_t flags);
+    };
+
+    /// Opens a non-blocking SO_REUSEPORT listening socket. Returns -1 after logging on failure.
+    [[nodiscard]] int open_listener(const boost::asio::ip::tcp::endpoint &endpoint) noexcept;
+
+} // namespace mehara::prapancha::uring
+
+#endif // PRAPANCHA_SERVER_URING_RING_H_
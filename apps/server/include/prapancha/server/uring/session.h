@@ -0,0 +1,512 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SERVER_URING_SESSION_H_
+#define PRAPANCHA_SERVER_URING_SESSION_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <liburing.h>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <prapancha/server/arena.h>
+#include <prapancha/server/beast_adapter.h>
+#include <prapancha/server/configuration.h>
+#include <prapancha/server/http.h>
+#include <prapancha/server/incoming.h>
+#include <prapancha/server/logger_registry.h>
+#include <prapancha/server/outgoing.h>
+#include <prapancha/server/responder.h>
+#include <prapancha/server/uring/ring.h>
+
+namespace mehara::prapancha::uring {
+
+    /// @brief HTTP/1.1 keep-alive connection driven by completions on its thread's Ring.
+    ///
+    /// The socket is a registered (direct) descriptor. Reads select a buffer from the ring's provided pool and every
+    /// read carries a linked timeout for the keep-alive deadline. A response that fits in one send is linked to the
+    /// next read, so answering a request and waiting for the following one cost a single submission. Requests are
+    /// parsed with Beast and dispatched through the same RequestView / Router::dispatch path and per-request Arena as
+    /// the Asio Session; pipelined requests are answered one after another in arrival order. Bodies are admitted
+    /// against the route's BodyLimit as soon as the header is parsed, exactly as the Asio Session does.
+    template<typename Router>
+    class Session : public std::enable_shared_from_this<Session<Router>> {
+    public:
+        using Registry = std::unordered_map<Session *, std::shared_ptr<Session>>;
+
+    private:
+        using RequestBody = boost::beast::http::vector_body<uint8_t, std::pmr::polymorphic_allocator<uint8_t>>;
+        using RequestParser = boost::beast::http::request_parser<RequestBody, std::pmr::polymorphic_allocator<char>>;
+        using StreamingParser = boost::beast::http::request_parser<boost::beast::http::buffer_body,
+                                                                   std::pmr::polymorphic_allocator<char>>;
+
+        static constexpr std::size_t file_chunk_size = 64 * 1024;
+
+        Ring &ring_;
+        Registry &registry_;
+        int file_;
+        Operation<Session> receive_{*this, &Session::on_receive};
+        Operation<Session> send_{*this, &Session::on_send};
+        Operation<Session> continue_{*this, &Session::on_continue};
+        Operation<Session> timeout_{*this, &Session::on_settled};
+        Operation<Session> cancel_{*this, &Session::on_settled};
+        Operation<Session> close_{*this, &Session::on_settled};
+        __kernel_timespec idle_{};
+        boost::beast::flat_buffer buffer_;
+        // Declared before the parser and the outgoing message so it is destroyed after them.
+        Arena arena_{configuration::Active->network.arena_size};
+        std::optional<RequestParser> parser_;
+        std::optional<StreamingParser> streaming_;
+        http::BodyStream body_stream_;
+        std::uint8_t *chunk_ = nullptr;
+        outgoing::Message outgoing_;
+        std::vector<iovec> iov_;
+        msghdr message_{};
+        std::unique_ptr<char[]> file_chunk_;
+        std::uint32_t served_ = 0;
+        std::uint32_t in_flight_ = 0;
+        bool reading_ = false;
+        bool writing_ = false;
+        bool pending_ = false;
+        bool keep_alive_ = false;
+        bool admitted_ = false;
+        bool receiving_ = false; ///< A streaming route is still being fed its body.
+        bool closing_ = false;
+
+    public:
+        Session(Ring &ring, Registry &registry, const int file) : ring_(ring), registry_(registry), file_(file) {
+            idle_.tv_sec = configuration::Active->network.keep_alive_timeout;
+        }
+
+        Session(const Session &) = delete;
+        Session &operator=(const Session &) = delete;
+
+        void run() { do_receive(); }
+
+    private:
+        [[nodiscard]] io_uring_sqe *submit(Completion &completion) {
+            ++in_flight_;
+            return ring_.prepare(completion);
+        }
+
+        void do_receive() {
+            reading_ = true;
+            auto *sqe = submit(receive_);
+            io_uring_prep_recv(sqe, file_, nullptr, 0, 0);
+            sqe->flags |= IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT | IOSQE_IO_LINK;
+            sqe->buf_group = Ring::buffer_group;
+            io_uring_prep_link_timeout(submit(timeout_), &idle_, 0);
+        }
+
+        void on_receive(const std::int32_t result, const std::uint32_t flags) {
+            --in_flight_;
+            reading_ = false;
+            if (result > 0) {
+                const auto bytes = ring_.buffer(flags, result);
+                const auto destination = buffer_.prepare(bytes.size());
+                std::memcpy(destination.data(), bytes.data(), bytes.size());
+                buffer_.commit(bytes.size());
+            }
+            if (flags & IORING_CQE_F_BUFFER) {
+                ring_.release(flags);
+            }
+            if (closing_) {
+                return settle();
+            }
+            if (result == -ENOBUFS) {
+                // Every provided buffer is in use; queue behind the connections that hold them.
+                return do_receive();
+            }
+            if (result == -ECANCELED && writing_) {
+                // The linked send came up short; the read is re-armed once the response is out.
+                return;
+            }
+            if (result == 0 && receiving_) {
+                // The body will never finish; dropping the sink releases whatever the handler captured in it.
+                body_stream_ = {};
+                return do_close();
+            }
+            if (result == 0 && (pending_ || writing_)) {
+                // Half-closed by the peer; answer what was asked, then close.
+                keep_alive_ = false;
+                return;
+            }
+            if (result <= 0) {
+                return do_close();
+            }
+            process();
+        }
+
+        /// Feeds buffered bytes to the current request, whether that is a header still being parsed or a body being
+        /// streamed to its handler. Reads more when the buffer runs dry and the request still needs bytes.
+        void process() {
+            while (!closing_) {
+                if (receiving_) {
+                    if (buffer_.size() == 0 || !stream_chunk()) {
+                        break;
+                    }
+                    continue;
+                }
+                if (pending_ || buffer_.size() == 0 || !parse()) {
+                    break;
+                }
+            }
+            if (!closing_ && !reading_ && (receiving_ || !pending_)) {
+                do_receive();
+            }
+        }
+
+        /// Advances the buffered parse. Returns false once more bytes are needed or the request has been dispatched.
+        bool parse() {
+            if (!parser_) {
+                const std::pmr::polymorphic_allocator<uint8_t> alloc(&arena_);
+                parser_.emplace(std::piecewise_construct, std::make_tuple(alloc),
+                                std::make_tuple(std::pmr::polymorphic_allocator<char>(alloc)));
+            }
+            boost::beast::error_code ec;
+            const std::size_t consumed = parser_->put(buffer_.data(), ec);
+            buffer_.consume(consumed);
+            if (ec == boost::beast::http::error::need_more || (!ec && consumed == 0 && !parser_->is_done())) {
+                return false;
+            }
+            if (ec == boost::beast::http::error::body_limit) {
+                reject();
+                return false;
+            }
+            if (ec) {
+                Loggers::App().log_info("प्रपञ्च — Prapancha: Malformed request [{}]: {}", ec.value(), ec.message());
+                do_close();
+                return false;
+            }
+            if (!admitted_ && parser_->is_header_done()) {
+                admitted_ = true;
+                if (!admit()) {
+                    return false;
+                }
+                if (receiving_) {
+                    return true;
+                }
+            }
+            if (parser_->is_done()) {
+                dispatch(http::from_beast(parser_->get(), &arena_));
+                return false;
+            }
+            return true;
+        }
+
+        /// Applies the route's body policy to a freshly parsed header. Returns false if the request went no further.
+        bool admit() {
+            auto &req = parser_->get();
+            if (req.version() != 11) {
+                Loggers::App().log_info("प्रपञ्च — Prapancha: Request version {} not supported.", req.version());
+                do_close();
+                return false;
+            }
+            keep_alive_ = req.keep_alive() && ++served_ < configuration::Active->network.max_requests_per_connection;
+            const auto limit = Router::body_limit(http::from_beast(req.method()), req.target());
+            switch (incoming::admit(*parser_, limit)) {
+                case incoming::Admission::Reject:
+                    reject();
+                    return false;
+                case incoming::Admission::Continue:
+                    do_continue();
+                    break;
+                case incoming::Admission::Accept:
+                    break;
+            }
+            if (limit.streaming) {
+                // Dispatched on the header alone; the body follows through the request's BodyStream.
+                auto &parser = streaming_.emplace(std::move(*parser_));
+                parser.eager(true);
+                chunk_ = static_cast<std::uint8_t *>(arena_.allocate(http::BodyLimit::ChunkSize, 1));
+                receiving_ = true;
+                auto request = http::from_beast(parser.get().base(), &arena_);
+                request.stream = &body_stream_;
+                dispatch(std::move(request));
+            }
+            return true;
+        }
+
+        /// Moves the next run of body bytes into the arena chunk and hands it to the sink. Returns false once more
+        /// bytes are needed or the connection is closing.
+        bool stream_chunk() {
+            auto &parser = *streaming_;
+            auto &body = parser.get().body();
+            body.data = chunk_;
+            body.size = http::BodyLimit::ChunkSize;
+            boost::beast::error_code ec;
+            const std::size_t consumed = parser.put(buffer_.data(), ec);
+            buffer_.consume(consumed);
+            const bool starved = ec == boost::beast::http::error::need_more;
+            if (starved || ec == boost::beast::http::error::need_buffer) {
+                ec = {};
+            }
+            if (ec) {
+                // The handler owns the response already, so a body cut short or over the limit ends the connection.
+                body_stream_ = {};
+                do_close();
+                return false;
+            }
+            const std::size_t produced = http::BodyLimit::ChunkSize - body.size;
+            const bool last = parser.is_done();
+            if (produced > 0 || last) {
+                body_stream_.deliver({chunk_, produced}, last);
+            }
+            if (last) {
+                receiving_ = false;
+                // The response went out first; the request could not be recycled until its body had ended.
+                if (!pending_) {
+                    recycle();
+                }
+                return true;
+            }
+            return !starved && consumed > 0;
+        }
+
+        /// Answers 413 in place of a request whose body was refused, or 404/405 when no route would have taken it.
+        /// The unread body makes the connection unusable.
+        void reject() {
+            keep_alive_ = false;
+            const auto &req = parser_->get();
+            if (!Router::routed(http::from_beast(req.method()), req.target())) {
+                return dispatch(http::from_beast(req.base(), &arena_));
+            }
+            pending_ = true;
+            on_response(incoming::too_large(&arena_));
+        }
+
+        /// Sends the interim 100 Continue. A final response produced meanwhile waits for it in on_continue().
+        void do_continue() {
+            writing_ = true;
+            auto *sqe = submit(continue_);
+            io_uring_prep_send(sqe, file_, incoming::continue_response.data(), incoming::continue_response.size(),
+                               MSG_WAITALL | MSG_NOSIGNAL);
+            sqe->flags |= IOSQE_FIXED_FILE;
+        }
+
+        void on_continue(const std::int32_t result, std::uint32_t) {
+            --in_flight_;
+            writing_ = false;
+            if (closing_) {
+                return settle();
+            }
+            if (result < 0) {
+                return do_close();
+            }
+            if (!std::holds_alternative<std::monostate>(outgoing_)) {
+                do_send();
+            }
+        }
+
+        void dispatch(http::RequestView &&request) {
+            pending_ = true;
+            // The view borrows from the parser, which is only released once this request's response is written.
+            http::Responder send = [self = this->shared_from_this()](http::Response &&response) {
+                self->on_response(std::move(response));
+            };
+            Router::dispatch(std::move(request), std::move(send));
+        }
+
+        void on_response(http::Response &&response) {
+            // Handlers may complete on any thread; hop back onto the ring's thread before touching the connection.
+            ring_.dispatch([self = this->shared_from_this(), response = std::move(response)]() mutable {
+                if (self->closing_) {
+                    self->pending_ = false;
+                    return;
+                }
+                outgoing::prepare(self->outgoing_, self->arena_, std::move(response), self->keep_alive_);
+                if (!self->writing_) {
+                    self->do_send();
+                }
+            });
+        }
+
+        /// Collects the next run of bytes for the current response and submits them as one sendmsg.
+        void do_send() {
+            iov_.clear();
+            boost::beast::error_code ec;
+            auto collect = [&](auto &serializer) {
+                serializer.next(ec, [&](boost::beast::error_code &, const auto &buffers) {
+                    for (auto it = boost::asio::buffer_sequence_begin(buffers);
+                         it != boost::asio::buffer_sequence_end(buffers); ++it) {
+                        iov_.push_back({const_cast<void *>(it->data()), it->size()});
+                    }
+                });
+            };
+            std::visit(
+                    [&]<typename Message>(Message &message) {
+                        if constexpr (std::same_as<Message, outgoing::File>) {
+                            if (!message.serializer.is_header_done()) {
+                                return collect(message.serializer);
+                            }
+                            collect_file(message, ec);
+                        } else if constexpr (std::same_as<Message, outgoing::Stream>) {
+                            collect(message.serializer);
+                            if (ec == boost::beast::http::error::need_buffer) {
+                                ec = {};
+                                message.next_chunk();
+                                collect(message.serializer);
+                            }
+                        } else if constexpr (std::same_as<Message, outgoing::Sized>) {
+                            collect(message.serializer);
+                        }
+                    },
+                    outgoing_);
+            if (ec) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: Response serialization failed [{}]: {}", ec.value(),
+                                         ec.message());
+                return do_close();
+            }
+            if (iov_.empty()) {
+                return finish();
+            }
+            message_ = {};
+            message_.msg_iov = iov_.data();
+            message_.msg_iovlen = iov_.size();
+            writing_ = true;
+            auto *sqe = submit(send_);
+            io_uring_prep_sendmsg(sqe, file_, &message_, MSG_WAITALL | MSG_NOSIGNAL);
+            sqe->flags |= IOSQE_FIXED_FILE;
+            // A sized response goes out in this one send, so the wait for the next request can ride along with it.
+            if (keep_alive_ && !reading_ && !receiving_ && buffer_.size() == 0 &&
+                std::holds_alternative<outgoing::Sized>(outgoing_)) {
+                sqe->flags |= IOSQE_IO_LINK;
+                do_receive();
+            }
+        }
+
+        /// File bytes are read through the page cache into one reusable chunk and sent like any other buffer.
+        void collect_file(outgoing::File &file, boost::beast::error_code &ec) {
+            if (file.remaining == 0) {
+                return;
+            }
+            if (!file_chunk_) {
+                file_chunk_ = std::make_unique_for_overwrite<char[]>(file_chunk_size);
+            }
+            const std::size_t wanted = std::min<std::uint64_t>(file.remaining, file_chunk_size);
+            ssize_t read = 0;
+            do {
+                read = ::pread(file.file.native_handle(), file_chunk_.get(), wanted, static_cast<off_t>(file.offset));
+            } while (read < 0 && errno == EINTR);
+            if (read <= 0) {
+                // A short file leaves the advertised Content-Length unmet; the connection cannot be reused.
+                ec = read < 0 ? boost::beast::error_code(errno, boost::system::system_category())
+                              : boost::beast::error_code(boost::asio::error::eof);
+                return;
+            }
+            iov_.push_back({file_chunk_.get(), static_cast<std::size_t>(read)});
+        }
+
+        void on_send(const std::int32_t result, std::uint32_t) {
+            --in_flight_;
+            writing_ = false;
+            if (closing_) {
+                return settle();
+            }
+            if (result < 0) {
+                return do_close();
+            }
+            const auto written = static_cast<std::size_t>(result);
+            const bool done = std::visit(
+                    [&]<typename Message>(Message &message) {
+                        if constexpr (std::same_as<Message, outgoing::File>) {
+                            if (!message.serializer.is_header_done()) {
+                                message.serializer.consume(written);
+                            } else {
+                                message.offset += written;
+                                message.remaining -= written;
+                            }
+                            return message.serializer.is_header_done() && message.remaining == 0;
+                        } else if constexpr (std::same_as<Message, std::monostate>) {
+                            return true;
+                        } else {
+                            message.serializer.consume(written);
+                            return message.serializer.is_done();
+                        }
+                    },
+                    outgoing_);
+            if (!done) {
+                return do_send();
+            }
+            finish();
+        }
+
+        /// Moves on to the next request once the response is out, unless a streamed body is still arriving.
+        void finish() {
+            outgoing_.template emplace<std::monostate>();
+            pending_ = false;
+            if (receiving_ && keep_alive_) {
+                return process();
+            }
+            recycle();
+            process();
+        }
+
+        /// Releases the finished request's parsers, body stream and arena.
+        void recycle() {
+            streaming_.reset();
+            parser_.reset();
+            body_stream_ = {};
+            chunk_ = nullptr;
+            admitted_ = false;
+            receiving_ = false;
+            if (const std::size_t used = arena_.reset(); used > 0) {
+                Loggers::App().log_debug([&] {
+                    return std::format("प्रपञ्च — Prapancha: Request arena released {} of {} bytes.", used,
+                                       arena_.capacity());
+                });
+            }
+            if (!keep_alive_) {
+                do_close();
+            }
+        }
+
+        /// Cancels whatever is still queued on the socket and closes its direct descriptor. The session leaves the
+        /// registry once the last of those completions has been reaped.
+        void do_close() {
+            if (closing_) {
+                return;
+            }
+            closing_ = true;
+            auto *cancel = submit(cancel_);
+            io_uring_prep_cancel_fd(cancel, file_, IORING_ASYNC_CANCEL_FD_FIXED | IORING_ASYNC_CANCEL_ALL);
+            cancel->flags |= IOSQE_IO_HARDLINK;
+            io_uring_prep_close_direct(submit(close_), static_cast<unsigned>(file_));
+        }
+
+        void on_settled(std::int32_t, std::uint32_t) {
+            --in_flight_;
+            settle();
+        }
+
+        void settle() {
+            if (closing_ && in_flight_ == 0) {
+                // The registry may hold the last reference; keep this alive until the erase has returned.
+                const auto self = this->shared_from_this();
+                registry_.erase(this);
+            }
+        }
+    };
+
+} // namespace mehara::prapancha::uring
+
+#endif // PRAPANCHA_SERVER_URING_SESSION_H_
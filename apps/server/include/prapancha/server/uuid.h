@@ -6,6 +6,10 @@
 #define PRAPANCHA_SERVER_UUID_H_
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 
 namespace mehara::prapancha {
 
@@ -41,4 +45,14 @@ namespace mehara::prapancha {
 
 } // namespace mehara::prapancha
 
+/// Hashes the trailing random bytes of a v7 UUID, which are already uniform; the leading timestamp is not.
+template<>
+struct std::hash<mehara::prapancha::UUID> {
+    std::size_t operator()(const mehara::prapancha::UUID &id) const noexcept {
+        std::uint64_t tail;
+        std::memcpy(&tail, id.data().data() + mehara::prapancha::UUID::bytes_length - sizeof(tail), sizeof(tail));
+        return static_cast<std::size_t>(tail);
+    }
+};
+
 #endif // PRAPANCHA_SERVER_UUID_H_
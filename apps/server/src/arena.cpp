@@ -0,0 +1,46 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <prapancha/server/arena.h>
+
+namespace mehara::prapancha {
+
+    Arena::Arena(const std::size_t capacity) :
+        capacity_(capacity), initial_(std::make_unique_for_overwrite<std::byte[]>(capacity)),
+        resource_(initial_.get(), capacity, std::pmr::new_delete_resource()) {}
+
+    std::size_t Arena::used() const noexcept { return used_; }
+
+    std::size_t Arena::capacity() const noexcept { return capacity_; }
+
+    std::size_t Arena::reset() noexcept {
+        const std::size_t used = used_;
+        if (used == 0) {
+            return 0;
+        }
+        resource_.release();
+        used_ = 0;
+        auto &totals = statistics();
+        totals.requests.fetch_add(1, std::memory_order_relaxed);
+        totals.bytes.fetch_add(used, std::memory_order_relaxed);
+        if (used > capacity_) {
+            totals.overflows.fetch_add(1, std::memory_order_relaxed);
+        }
+        auto peak = totals.peak.load(std::memory_order_relaxed);
+        while (used > peak && !totals.peak.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {
+        }
+        return used;
+    }
+
+    Arena::Statistics &Arena::statistics() noexcept {
+        static Statistics totals;
+        return totals;
+    }
+
+    void *Arena::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+        used_ += bytes;
+        return resource_.allocate(bytes, alignment);
+    }
+
+} // namespace mehara::prapancha
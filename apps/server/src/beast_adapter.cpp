@@ -27,28 +27,25 @@ namespace mehara::prapancha::http {
         }
     }
 
-    Request from_beast(boost::beast::http::request<boost::beast::http::vector_body<uint8_t>> &beast_request) {
-        Request request;
-        request.target = std::string(beast_request.target());
-        request.method = from_beast(beast_request.method());
-        request.headers.reserve(std::distance(beast_request.begin(), beast_request.end()));
-        for (const auto &field: beast_request) {
-            request.headers.push_back({std::string(field.name_string()), std::string(field.value())});
-        }
-        request.body = std::move(beast_request.body());
-        return request;
+    RequestView from_beast(const BeastRequest &beast_request, Arena *arena) noexcept {
+        return {from_beast(beast_request.method()), beast_request.target(), beast_request.body(),
+                &beast_request.base(), arena};
+    }
+
+    RequestView from_beast(const boost::beast::http::request_header<Fields> &beast_header,
+                           Arena *arena) noexcept {
+        return {from_beast(beast_header.method()), beast_header.target(), {}, &beast_header, arena};
     }
 
-    boost::beast::http::response<boost::beast::http::string_body> to_beast(Response &&response) {
-        boost::beast::http::response<boost::beast::http::string_body> beast_response;
-        beast_response.version(11);
-        beast_response.result(static_cast<boost::beast::http::status>(response.status));
-        for (const auto &[name, value]: response.headers) {
-            beast_response.set(name, value);
+    boost::beast::http::response_header<Fields> to_beast(const Status status, const std::pmr::vector<Header> &headers,
+                                                         const Allocator alloc) {
+        boost::beast::http::response_header<Fields> beast_header{std::pmr::polymorphic_allocator<char>(alloc)};
+        beast_header.version(11);
+        beast_header.result(static_cast<boost::beast::http::status>(status));
+        for (const auto &[name, value]: headers) {
+            beast_header.set(name, value);
         }
-        beast_response.body() = std::move(response.body);
-        beast_response.prepare_payload();
-        return beast_response;
+        return beast_header;
     }
 
 } // namespace mehara::prapancha::http
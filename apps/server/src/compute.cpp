@@ -0,0 +1,41 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <prapancha/server/compute.h>
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+namespace mehara::prapancha::compute {
+
+    namespace {
+
+        std::unique_ptr<boost::asio::thread_pool> pool;
+        std::size_t threads = 0;
+
+    } // namespace
+
+    void initialize(int thread_count) {
+        if (pool) {
+            return;
+        }
+        if (thread_count == 0) {
+            thread_count = std::max<int>(1, static_cast<int>(std::thread::hardware_concurrency() / 2));
+        }
+        threads = static_cast<std::size_t>(thread_count);
+        pool = std::make_unique<boost::asio::thread_pool>(threads);
+    }
+
+    Executor executor() noexcept { return pool->get_executor(); }
+
+    std::size_t thread_count() noexcept { return threads; }
+
+    void shutdown() noexcept {
+        if (pool) {
+            pool->join();
+        }
+    }
+
+} // namespace mehara::prapancha::compute
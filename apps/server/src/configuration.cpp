@@ -42,6 +42,14 @@ namespace mehara::prapancha::configuration {
                 config.environment = Configuration::Environment::Production;
             } else if (current_arg == "--development") {
                 config.environment = Configuration::Environment::Development;
+            } else if (current_arg == "--shared") {
+                config.network.execution = Configuration::Network::Execution::Shared;
+            } else if (current_arg == "--sharded") {
+                config.network.execution = Configuration::Network::Execution::Sharded;
+            } else if (current_arg == "--asio") {
+                config.network.transport = Configuration::Network::Transport::Asio;
+            } else if (current_arg == "--io_uring") {
+                config.network.transport = Configuration::Network::Transport::IoUring;
             } else if (current_arg == "--port" && (i + 1) < args.size()) {
                 const std::string_view val = args[++i];
                 auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.network.port);
@@ -56,17 +64,203 @@ namespace mehara::prapancha::configuration {
                     std::cerr << "Warning: Invalid thread_count '" << val
                               << "'. Using default: " << Configuration::Network::AutoDetectThreads << "\n";
                 }
+            } else if (current_arg == "--max_requests" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(),
+                                                 config.network.max_requests_per_connection);
+                if (ec != std::errc() || config.network.max_requests_per_connection == 0) {
+                    std::cerr << "Warning: Invalid max_requests '" << val << "'. Using default: "
+                              << Configuration::Network::DefaultMaxRequestsPerConnection << "\n";
+                    config.network.max_requests_per_connection =
+                            Configuration::Network::DefaultMaxRequestsPerConnection;
+                }
+            } else if (current_arg == "--keep_alive_timeout" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] =
+                        std::from_chars(val.data(), val.data() + val.size(), config.network.keep_alive_timeout);
+                if (ec != std::errc() || config.network.keep_alive_timeout == 0) {
+                    std::cerr << "Warning: Invalid keep_alive_timeout '" << val
+                              << "'. Using default: " << Configuration::Network::DefaultKeepAliveTimeout << "\n";
+                    config.network.keep_alive_timeout = Configuration::Network::DefaultKeepAliveTimeout;
+                }
+            } else if (current_arg == "--pipeline_depth" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.network.pipeline_depth);
+                if (ec != std::errc() || config.network.pipeline_depth == 0) {
+                    std::cerr << "Warning: Invalid pipeline_depth '" << val
+                              << "'. Using default: " << Configuration::Network::DefaultPipelineDepth << "\n";
+                    config.network.pipeline_depth = Configuration::Network::DefaultPipelineDepth;
+                }
+            } else if (current_arg == "--arena_size" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.network.arena_size);
+                if (ec != std::errc() || config.network.arena_size == 0) {
+                    std::cerr << "Warning: Invalid arena_size '" << val
+                              << "'. Using default: " << Configuration::Network::DefaultArenaSize << "\n";
+                    config.network.arena_size = Configuration::Network::DefaultArenaSize;
+                }
+            } else if (current_arg == "--max_concurrent_streams" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] =
+                        std::from_chars(val.data(), val.data() + val.size(), config.network.max_concurrent_streams);
+                if (ec != std::errc() || config.network.max_concurrent_streams == 0) {
+                    std::cerr << "Warning: Invalid max_concurrent_streams '" << val
+                              << "'. Using default: " << Configuration::Network::DefaultMaxConcurrentStreams << "\n";
+                    config.network.max_concurrent_streams = Configuration::Network::DefaultMaxConcurrentStreams;
+                }
+            } else if (current_arg == "--tls_certificate" && (i + 1) < args.size()) {
+                config.network.tls_certificate = std::string(args[++i]);
+            } else if (current_arg == "--tls_private_key" && (i + 1) < args.size()) {
+                config.network.tls_private_key = std::string(args[++i]);
+            } else if (current_arg == "--tls_session_cache" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.network.tls_session_cache);
+                if (ec != std::errc()) {
+                    std::cerr << "Warning: Invalid tls_session_cache '" << val
+                              << "'. Using default: " << Configuration::Network::DefaultTlsSessionCache << "\n";
+                    config.network.tls_session_cache = Configuration::Network::DefaultTlsSessionCache;
+                }
+            } else if (current_arg == "--tls_tickets" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.network.tls_tickets);
+                if (ec != std::errc()) {
+                    std::cerr << "Warning: Invalid tls_tickets '" << val
+                              << "'. Using default: " << Configuration::Network::DefaultTlsTickets << "\n";
+                    config.network.tls_tickets = Configuration::Network::DefaultTlsTickets;
+                }
+            } else if (current_arg == "--compute_threads" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.compute.thread_count);
+                if (ec != std::errc() || config.compute.thread_count < 0) {
+                    std::cerr << "Warning: Invalid compute_threads '" << val
+                              << "'. Using default: " << Configuration::Compute::AutoDetectThreads << "\n";
+                    config.compute.thread_count = Configuration::Compute::AutoDetectThreads;
+                }
+            } else if (current_arg == "--hash_workers" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.hashing.workers);
+                if (ec != std::errc()) {
+                    std::cerr << "Warning: Invalid hash_workers '" << val << "'. Using default: 0\n";
+                    config.hashing.workers = 0;
+                }
+            } else if (current_arg == "--hash_queue" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.hashing.queue_capacity);
+                if (ec != std::errc() || config.hashing.queue_capacity == 0) {
+                    std::cerr << "Warning: Invalid hash_queue '" << val
+                              << "'. Using default: " << Configuration::Hashing::DefaultQueueCapacity << "\n";
+                    config.hashing.queue_capacity = Configuration::Hashing::DefaultQueueCapacity;
+                }
+            } else if (current_arg == "--hash_memory" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.hashing.memory_budget);
+                if (ec != std::errc() || config.hashing.memory_budget == 0) {
+                    std::cerr << "Warning: Invalid hash_memory '" << val
+                              << "'. Using default: " << Configuration::Hashing::DefaultMemoryBudget << "\n";
+                    config.hashing.memory_budget = Configuration::Hashing::DefaultMemoryBudget;
+                }
+            } else if (current_arg == "--argon2_threads" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.hashing.argon2_threads);
+                if (ec != std::errc() || config.hashing.argon2_threads == 0) {
+                    std::cerr << "Warning: Invalid argon2_threads '" << val
+                              << "'. Using default: " << Configuration::Hashing::DefaultArgon2Threads << "\n";
+                    config.hashing.argon2_threads = Configuration::Hashing::DefaultArgon2Threads;
+                }
+            } else if (current_arg == "--argon2_max_threads" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] =
+                        std::from_chars(val.data(), val.data() + val.size(), config.hashing.argon2_max_threads);
+                if (ec != std::errc()) {
+                    std::cerr << "Warning: Invalid argon2_max_threads '" << val << "'. Using default: 0\n";
+                    config.hashing.argon2_max_threads = 0;
+                }
+            } else if (current_arg == "--argon2_latency" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.hashing.argon2_latency);
+                if (ec != std::errc()) {
+                    std::cerr << "Warning: Invalid argon2_latency '" << val << "'. Using default: 0\n";
+                    config.hashing.argon2_latency = 0;
+                }
+            } else if (current_arg == "--argon2_max_memory" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] =
+                        std::from_chars(val.data(), val.data() + val.size(), config.hashing.argon2_max_memory);
+                if (ec != std::errc() || config.hashing.argon2_max_memory == 0) {
+                    std::cerr << "Warning: Invalid argon2_max_memory '" << val
+                              << "'. Using default: " << Configuration::Hashing::DefaultArgon2MaxMemory << "\n";
+                    config.hashing.argon2_max_memory = Configuration::Hashing::DefaultArgon2MaxMemory;
+                }
             } else if (current_arg == "--data_path" && (i + 1) < args.size()) {
                 config.persistence.root_path = std::string(args[++i]);
+            } else if (current_arg == "--file_storage") {
+                config.persistence.engine = Configuration::Persistence::Engine::File;
+            } else if (current_arg == "--log_storage") {
+                config.persistence.engine = Configuration::Persistence::Engine::Log;
+            } else if (current_arg == "--durability" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                if (val == "none") {
+                    config.persistence.durability = Configuration::Persistence::Durability::None;
+                } else if (val == "batched") {
+                    config.persistence.durability = Configuration::Persistence::Durability::Batched;
+                } else if (val == "per_write") {
+                    config.persistence.durability = Configuration::Persistence::Durability::PerWrite;
+                } else {
+                    std::cerr << "Warning: Invalid durability '" << val << "'. Using default: batched\n";
+                    config.persistence.durability = Configuration::Persistence::Durability::Batched;
+                }
+            } else if (current_arg == "--cache_memory" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] = std::from_chars(val.data(), val.data() + val.size(), config.persistence.cache_memory);
+                if (ec != std::errc()) {
+                    std::cerr << "Warning: Invalid cache_memory '" << val
+                              << "'. Using default: " << Configuration::Persistence::DefaultCacheMemory << "\n";
+                    config.persistence.cache_memory = Configuration::Persistence::DefaultCacheMemory;
+                }
+            } else if (current_arg == "--segment_size" && (i + 1) < args.size()) {
+                const std::string_view val = args[++i];
+                auto [ptr, ec] =
+                        std::from_chars(val.data(), val.data() + val.size(), config.persistence.segment_size);
+                if (ec != std::errc() || config.persistence.segment_size == 0) {
+                    std::cerr << "Warning: Invalid segment_size '" << val
+                              << "'. Using default: " << Configuration::Persistence::DefaultSegmentSize << "\n";
+                    config.persistence.segment_size = Configuration::Persistence::DefaultSegmentSize;
+                }
             } else if (current_arg == "--help") {
                 std::cout << "Prapancha Framework\n"
                           << "Usage: " << (argc > 0 ? argv[0] : "prapancha") << " [options]\n\n"
                           << "Options:\n"
                           << "  --production         Execute in a production environment\n"
                           << "  --development        Execute in a development environment\n"
+                          << "  --shared             Serve all connections from one shared io_context\n"
+                          << "  --sharded            Serve connections from one pinned io_context per core\n"
+                          << "  --asio               Drive sockets through Boost.Asio (default)\n"
+                          << "  --io_uring           Drive sockets through one io_uring per pinned core\n"
                           << "  --port <number>      Set the network listener port\n"
                           << "  --thread_count <n>   Set number of worker threads (0 for auto)\n"
+                          << "  --max_requests <n>   Set requests served per keep-alive connection\n"
+                          << "  --keep_alive_timeout <s> Set keep-alive idle timeout in seconds\n"
+                          << "  --pipeline_depth <n> Set pipelined requests in flight per connection\n"
+                          << "  --arena_size <bytes> Set the per-request arena block size\n"
+                          << "  --max_concurrent_streams <n> Set HTTP/2 streams open per connection\n"
+                          << "  --tls_certificate <path> Serve TLS with this PEM certificate chain\n"
+                          << "  --tls_private_key <path> Set the PEM private key for --tls_certificate\n"
+                          << "  --tls_session_cache <n> Set resumable TLS sessions kept in memory\n"
+                          << "  --tls_tickets <n>    Set TLS 1.3 session tickets issued per handshake\n"
+                          << "  --compute_threads <n> Set threads for CPU-bound handlers (0 for auto)\n"
+                          << "  --hash_workers <n>   Set Argon2id hashing threads (0 for auto)\n"
+                          << "  --hash_queue <n>     Set hashes queued before new ones are refused\n"
+                          << "  --hash_memory <MiB>  Set the memory all running hashes may hold together\n"
+                          << "  --argon2_threads <n> Set OpenSSL threads one Argon2id hash may use\n"
+                          << "  --argon2_max_threads <n> Cap OpenSSL threads across all hashes (0 for auto)\n"
+                          << "  --argon2_latency <ms> Calibrate Argon2id costs to this hash latency at startup\n"
+                          << "  --argon2_max_memory <MiB> Set the most memory calibration may give one hash\n"
                           << "  --data_path <path>   Set the persistence storage root path\n"
+                          << "  --file_storage       Store each record in its own file (default)\n"
+                          << "  --log_storage        Append records to segment files with an in-memory index\n"
+                          << "  --segment_size <MiB> Set the size at which a log segment is sealed\n"
+                          << "  --durability <mode>  Flush log writes: none, batched (default) or per_write\n"
+                          << "  --cache_memory <MiB> Set memory for decoded models cached per store (0 disables)\n"
                           << "  --help               Show help information\n";
                 std::exit(0);
             }
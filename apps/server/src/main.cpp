@@ -6,7 +6,5 @@
 
 int main(int argc, char *argv[]) {
 
-    mehara::prapancha::run(argc, argv);
-
-    return 0;
+    return mehara::prapancha::run(argc, argv);
 }
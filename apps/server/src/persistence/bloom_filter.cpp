@@ -0,0 +1,52 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <prapancha/server/persistence/bloom_filter.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace mehara::prapancha::persistence {
+
+    namespace {
+
+        constexpr int probes = 7;
+
+        /// Second, independent hash for double hashing; forced odd so successive probes never repeat a bit.
+        constexpr std::uint64_t rehash(std::uint64_t hash) noexcept {
+            hash ^= hash >> 33;
+            hash *= 0xFF51AFD7ED558CCDULL;
+            hash ^= hash >> 33;
+            return hash | 1;
+        }
+
+    } // namespace
+
+    BloomFilter::BloomFilter(const std::size_t capacity) :
+        capacity_(std::max(capacity, MinimumCapacity)), mask_(std::bit_ceil(capacity_ * BitsPerKey) - 1),
+        words_(std::make_unique<std::atomic<std::uint64_t>[]>((mask_ + 1) / 64)) {}
+
+    void BloomFilter::insert(const std::uint64_t hash) noexcept {
+        const std::uint64_t step = rehash(hash);
+        std::uint64_t bit = hash;
+        for (int i = 0; i < probes; ++i, bit += step) {
+            const std::uint64_t position = bit & mask_;
+            words_[position / 64].fetch_or(std::uint64_t{1} << (position % 64), std::memory_order_relaxed);
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool BloomFilter::may_contain(const std::uint64_t hash) const noexcept {
+        const std::uint64_t step = rehash(hash);
+        std::uint64_t bit = hash;
+        for (int i = 0; i < probes; ++i, bit += step) {
+            const std::uint64_t position = bit & mask_;
+            if ((words_[position / 64].load(std::memory_order_relaxed) & (std::uint64_t{1} << (position % 64))) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace mehara::prapancha::persistence
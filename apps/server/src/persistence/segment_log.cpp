@@ -0,0 +1,506 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <prapancha/server/persistence/segment_log.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <span>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <prapancha/server/logger_registry.h>
+
+namespace mehara::prapancha::persistence {
+
+    namespace {
+
+        /// Frame header: CRC-32C of everything after it, payload length, kind, three reserved bytes, then the id.
+        constexpr std::size_t header_length = 12 + UUID::bytes_length;
+        constexpr std::string_view segment_extension = ".log";
+
+        constexpr std::array<std::uint32_t, 256> crc_table = [] {
+            std::array<std::uint32_t, 256> table{};
+            for (std::uint32_t i = 0; i < table.size(); ++i) {
+                std::uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc >> 1) ^ (0x82F63B78U & (0U - (crc & 1U)));
+                }
+                table[i] = crc;
+            }
+            return table;
+        }();
+
+        std::uint32_t crc32c(std::uint32_t crc, const std::string_view data) noexcept {
+            crc = ~crc;
+            for (const char byte: data) {
+                crc = crc_table[(crc ^ static_cast<std::uint8_t>(byte)) & 0xFFU] ^ (crc >> 8);
+            }
+            return ~crc;
+        }
+
+        std::uint32_t frame_crc(const std::string_view header, const std::string_view payload) noexcept {
+            return crc32c(crc32c(0, header.substr(4)), payload);
+        }
+
+        void frame(std::string &out, const UUID &id, const std::uint8_t kind, const std::string_view payload) {
+            std::array<char, header_length> header{};
+            const auto length = static_cast<std::uint32_t>(payload.size());
+            std::memcpy(header.data() + 4, &length, sizeof(length));
+            header[8] = static_cast<char>(kind);
+            std::memcpy(header.data() + 12, id.data().data(), UUID::bytes_length);
+            const std::uint32_t crc = frame_crc({header.data(), header.size()}, payload);
+            std::memcpy(header.data(), &crc, sizeof(crc));
+            out.append(header.data(), header.size());
+            out.append(payload);
+        }
+
+        struct Frame {
+            std::uint8_t kind;
+            UUID id;
+            std::string_view payload;
+        };
+
+        /// The intact frame at the start of `data`, if there is one.
+        std::optional<Frame> parse(const std::string_view data) noexcept {
+            if (data.size() < header_length) {
+                return std::nullopt;
+            }
+            std::uint32_t crc = 0;
+            std::uint32_t length = 0;
+            std::memcpy(&crc, data.data(), sizeof(crc));
+            std::memcpy(&length, data.data() + 4, sizeof(length));
+            if (data.size() - header_length < length) {
+                return std::nullopt;
+            }
+            const auto payload = data.substr(header_length, length);
+            if (frame_crc(data.substr(0, header_length), payload) != crc) {
+                return std::nullopt;
+            }
+            UUID::Bytes id;
+            std::memcpy(id.data(), data.data() + 12, id.size());
+            return Frame{static_cast<std::uint8_t>(data[8]), UUID(id), payload};
+        }
+
+        /// Calls `visit(frame, offset)` for each intact frame from the start of `data`; returns where they end.
+        template<typename Visit>
+        std::uint64_t scan(const std::string_view data, Visit &&visit) {
+            std::uint64_t offset = 0;
+            while (const auto frame = parse(data.substr(offset))) {
+                visit(*frame, offset);
+                offset += header_length + frame->payload.size();
+            }
+            return offset;
+        }
+
+        void raise_peak(std::atomic<std::uint64_t> &peak, const std::uint64_t value) noexcept {
+            std::uint64_t current = peak.load(std::memory_order_relaxed);
+            while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+
+        [[noreturn]] void fail(const std::string &what) {
+            throw std::system_error(errno, std::generic_category(), what);
+        }
+
+        std::string read_all(const int fd, const std::filesystem::path &path) {
+            struct stat status {};
+            if (::fstat(fd, &status) != 0) {
+                fail("stat " + path.string());
+            }
+            std::string data(static_cast<std::size_t>(status.st_size), '\0');
+            std::size_t done = 0;
+            while (done < data.size()) {
+                const ssize_t n = ::pread(fd, data.data() + done, data.size() - done, static_cast<off_t>(done));
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    fail("read " + path.string());
+                }
+                done += static_cast<std::size_t>(n);
+            }
+            return data;
+        }
+
+        void write_all(const int fd, std::string_view data, std::uint64_t offset) {
+            while (!data.empty()) {
+                const ssize_t n = ::pwrite(fd, data.data(), data.size(), static_cast<off_t>(offset));
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (n <= 0) {
+                    fail("append to segment");
+                }
+                data.remove_prefix(static_cast<std::size_t>(n));
+                offset += static_cast<std::uint64_t>(n);
+            }
+        }
+
+    } // namespace
+
+    SegmentLog::Segment::Segment(const std::uint64_t number, std::filesystem::path path, const int fd) noexcept :
+        number(number), path(std::move(path)), fd(fd) {}
+
+    SegmentLog::Segment::~Segment() { ::close(fd); }
+
+    SegmentLog::SegmentLog(std::filesystem::path directory, const Options options) :
+        directory_(std::move(directory)), options_(options) {
+        if (!std::filesystem::exists(directory_)) {
+            std::filesystem::create_directories(directory_);
+        }
+        recover();
+        if (options_.compaction_interval.count() > 0) {
+            compactor_ = std::jthread([this](const std::stop_token &stop) {
+                std::unique_lock lock(wake_mutex_);
+                while (!wake_.wait_for(lock, stop, options_.compaction_interval, [] { return false; })) {
+                    if (stop.stop_requested()) {
+                        return;
+                    }
+                    lock.unlock();
+                    try {
+                        compact();
+                    } catch (const std::exception &e) {
+                        Loggers::App().log_error("प्रपञ्च — Prapancha: Compaction of {} failed: {}",
+                                                 directory_.string(), e.what());
+                    }
+                    lock.lock();
+                }
+            });
+        }
+    }
+
+    SegmentLog::~SegmentLog() {
+        compactor_.request_stop();
+        if (compactor_.joinable()) {
+            compactor_.join();
+        }
+        std::lock_guard lock(writer_);
+        ::fdatasync(active_->fd);
+    }
+
+    std::shared_ptr<SegmentLog::Segment> SegmentLog::open_segment(const std::uint64_t number, const bool create) {
+        auto path = directory_ / std::format("{:020}{}", number, segment_extension);
+        const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT | O_EXCL : 0), 0644);
+        if (fd < 0) {
+            fail("open " + path.string());
+        }
+        return std::make_shared<Segment>(number, std::move(path), fd);
+    }
+
+    void SegmentLog::recover() {
+        std::vector<std::uint64_t> numbers;
+        for (const auto &entry: std::filesystem::directory_iterator(directory_)) {
+            const auto stem = entry.path().stem().string();
+            std::uint64_t number = 0;
+            const auto [end, ec] = std::from_chars(stem.data(), stem.data() + stem.size(), number);
+            if (entry.is_regular_file() && entry.path().extension() == segment_extension && ec == std::errc() &&
+                end == stem.data() + stem.size()) {
+                numbers.push_back(number);
+            }
+        }
+        std::ranges::sort(numbers);
+        for (const std::uint64_t number: numbers) {
+            auto segment = open_segment(number, false);
+            const std::string data = read_all(segment->fd, segment->path);
+            const std::uint64_t end = scan(data, [&](const Frame &frame, const std::uint64_t offset) {
+                const std::uint64_t length = header_length + frame.payload.size();
+                if (frame.kind == static_cast<std::uint8_t>(Kind::Put)) {
+                    place(frame.id, Location{segment, offset, length});
+                } else {
+                    forget(frame.id);
+                }
+            });
+            segment->size = data.size();
+            if (end < data.size() && number == numbers.back()) {
+                Loggers::App().log_warn("प्रपञ्च — Prapancha: Cutting a torn write of {} bytes from {}.",
+                                        data.size() - end, segment->path.string());
+                if (::ftruncate(segment->fd, static_cast<off_t>(end)) != 0) {
+                    fail("truncate " + segment->path.string());
+                }
+                segment->size = end;
+            } else if (end < data.size()) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: {} is damaged at byte {}; later frames are skipped.",
+                                         segment->path.string(), end);
+            }
+            segments_.emplace(number, std::move(segment));
+        }
+        if (segments_.empty()) {
+            segments_.emplace(1, open_segment(1, true));
+        }
+        active_ = segments_.rbegin()->second;
+    }
+
+    SegmentLog::Location SegmentLog::append(const std::string_view frames) {
+        if (active_->size > 0 && active_->size + frames.size() > options_.segment_size) {
+            ::fdatasync(active_->fd);
+            auto next = open_segment(active_->number + 1, true);
+            active_ = segments_.emplace(next->number, std::move(next)).first->second;
+        }
+        const std::uint64_t offset = active_->size;
+        try {
+            write_all(active_->fd, frames, offset);
+        } catch (...) {
+            // Leave no partial frame behind for later appends to follow.
+            [[maybe_unused]] const int ignored = ::ftruncate(active_->fd, static_cast<off_t>(offset));
+            throw;
+        }
+        active_->size += frames.size();
+        return Location{active_, offset, frames.size()};
+    }
+
+    void SegmentLog::place(const UUID &id, const Location &location) {
+        location.segment->live += location.length;
+        const auto [found, inserted] = index_.try_emplace(id, location);
+        if (!inserted) {
+            found->second.segment->live -= found->second.length;
+            found->second = location;
+            ++superseded_[id];
+        }
+    }
+
+    bool SegmentLog::forget(const UUID &id) {
+        const auto found = index_.find(id);
+        if (found == index_.end()) {
+            return false;
+        }
+        found->second.segment->live -= found->second.length;
+        index_.erase(found);
+        ++superseded_[id];
+        return true;
+    }
+
+    void SegmentLog::commit(Pending &pending) {
+        if (options_.durability == Durability::PerWrite) {
+            Pending *const batch[] = {&pending};
+            write(batch);
+        } else {
+            std::unique_lock lock(queue_mutex_);
+            queue_.push_back(&pending);
+            while (!pending.done) {
+                if (leading_) {
+                    committed_.wait(lock);
+                    continue;
+                }
+                leading_ = true;
+                const auto batch = std::exchange(queue_, {});
+                lock.unlock();
+                write(batch);
+                lock.lock();
+                leading_ = false;
+                for (Pending *const entry: batch) {
+                    entry->done = true;
+                }
+                committed_.notify_all();
+            }
+        }
+        if (pending.error) {
+            std::rethrow_exception(pending.error);
+        }
+    }
+
+    void SegmentLog::write(const std::span<Pending *const> batch) noexcept {
+        const auto start = std::chrono::steady_clock::now();
+        std::string frames;
+        std::size_t size = 0;
+        for (const Pending *const entry: batch) {
+            size += entry->frame.size();
+        }
+        std::lock_guard writer(writer_);
+        Location location;
+        try {
+            frames.reserve(size);
+            for (const Pending *const entry: batch) {
+                frames.append(entry->frame);
+            }
+            location = append(frames);
+            if (options_.durability != Durability::None) {
+                if (::fdatasync(location.segment->fd) != 0) {
+                    fail("sync " + location.segment->path.string());
+                }
+                metrics_.syncs.fetch_add(1, std::memory_order_relaxed);
+            }
+        } catch (...) {
+            const auto error = std::current_exception();
+            for (Pending *const entry: batch) {
+                entry->error = error;
+            }
+            return;
+        }
+        {
+            std::unique_lock index(index_mutex_);
+            std::uint64_t offset = location.offset;
+            for (Pending *const entry: batch) {
+                const std::uint64_t length = entry->frame.size();
+                if (entry->kind == Kind::Put) {
+                    place(entry->id, Location{location.segment, offset, length});
+                } else {
+                    entry->existed = forget(entry->id);
+                }
+                offset += length;
+            }
+        }
+        const auto elapsed = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                        .count());
+        metrics_.commits.fetch_add(1, std::memory_order_relaxed);
+        metrics_.writes.fetch_add(batch.size(), std::memory_order_relaxed);
+        metrics_.commit_nanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+        raise_peak(metrics_.peak_batch, batch.size());
+        raise_peak(metrics_.peak_commit_nanoseconds, elapsed);
+    }
+
+    void SegmentLog::put(const UUID &id, const std::string_view payload) {
+        Pending pending{id, Kind::Put, {}};
+        pending.frame.reserve(header_length + payload.size());
+        frame(pending.frame, id, static_cast<std::uint8_t>(Kind::Put), payload);
+        commit(pending);
+    }
+
+    std::optional<std::string> SegmentLog::get(const UUID &id) const {
+        Location location;
+        {
+            std::shared_lock lock(index_mutex_);
+            const auto found = index_.find(id);
+            if (found == index_.end()) {
+                return std::nullopt;
+            }
+            location = found->second;
+        }
+        std::array<char, header_length> header{};
+        std::string payload(location.length - header_length, '\0');
+        std::array<iovec, 2> parts{iovec{header.data(), header.size()}, iovec{payload.data(), payload.size()}};
+        ssize_t n = 0;
+        do {
+            n = ::preadv(location.segment->fd, parts.data(), parts.size(), static_cast<off_t>(location.offset));
+        } while (n < 0 && errno == EINTR);
+        std::uint32_t crc = 0;
+        std::memcpy(&crc, header.data(), sizeof(crc));
+        if (n != static_cast<ssize_t>(location.length) || frame_crc({header.data(), header.size()}, payload) != crc) {
+            return std::nullopt;
+        }
+        return payload;
+    }
+
+    bool SegmentLog::erase(const UUID &id) {
+        {
+            // Skips the tombstone for ids already absent; the batch decides the answer for ids still present.
+            std::shared_lock index(index_mutex_);
+            if (!index_.contains(id)) {
+                return false;
+            }
+        }
+        Pending pending{id, Kind::Tombstone, {}};
+        frame(pending.frame, id, static_cast<std::uint8_t>(Kind::Tombstone), {});
+        commit(pending);
+        return pending.existed;
+    }
+
+    std::vector<UUID> SegmentLog::ids() const {
+        std::shared_lock lock(index_mutex_);
+        std::vector<UUID> ids;
+        ids.reserve(index_.size());
+        for (const auto &[id, location]: index_) {
+            ids.push_back(id);
+        }
+        return ids;
+    }
+
+    void SegmentLog::compact() {
+        std::vector<std::shared_ptr<Segment>> candidates;
+        {
+            std::lock_guard writer(writer_);
+            std::shared_lock index(index_mutex_);
+            for (const auto &[number, segment]: segments_) {
+                const double share = options_.compaction_ratio * static_cast<double>(segment->size);
+                if (segment != active_ && (segment->live == 0 || static_cast<double>(segment->live) < share)) {
+                    candidates.push_back(segment);
+                }
+            }
+        }
+        for (const auto &segment: candidates) {
+            compact(segment);
+        }
+    }
+
+    void SegmentLog::compact(const std::shared_ptr<Segment> &segment) {
+        // Sealed segments never change, so reading and sorting out the live frames needs no lock.
+        const std::string data = read_all(segment->fd, segment->path);
+        struct Moved {
+            UUID id;
+            std::uint64_t from;
+            std::uint64_t to;
+            std::uint64_t length;
+        };
+        std::vector<Moved> moved;
+        std::vector<std::pair<UUID, std::string_view>> tombstones;
+        // Put frames deleted with this segment. Moving a live one supersedes its old copy here, so it counts too.
+        std::unordered_map<UUID, std::uint64_t> dropped;
+        std::string frames;
+        std::lock_guard writer(writer_);
+        if (!segments_.contains(segment->number)) {
+            return;
+        }
+        {
+            std::shared_lock index(index_mutex_);
+            scan(data, [&](const Frame &frame, const std::uint64_t offset) {
+                const std::uint64_t length = header_length + frame.payload.size();
+                if (frame.kind != static_cast<std::uint8_t>(Kind::Put)) {
+                    tombstones.emplace_back(frame.id, std::string_view(data).substr(offset, length));
+                    return;
+                }
+                ++dropped[frame.id];
+                const auto found = index_.find(frame.id);
+                if (found != index_.end() && found->second.segment == segment && found->second.offset == offset) {
+                    moved.push_back({frame.id, offset, frames.size(), length});
+                    frames.append(data, offset, length);
+                }
+            });
+            // A tombstone of an absent id still matters while a stale put of it survives in another segment.
+            for (const auto &[id, tombstone]: tombstones) {
+                const auto stale = superseded_.find(id);
+                const auto here = dropped.find(id);
+                if (!index_.contains(id) && stale != superseded_.end() &&
+                    stale->second > (here == dropped.end() ? 0 : here->second)) {
+                    frames.append(tombstone);
+                }
+            }
+        }
+        if (!frames.empty()) {
+            const Location location = append(frames);
+            std::unique_lock index(index_mutex_);
+            for (const auto &[id, from, to, length]: moved) {
+                // Writers are held off by writer_, so nothing can have superseded these frames since the scan.
+                place(id, Location{location.segment, location.offset + to, length});
+            }
+        }
+        if (::fdatasync(active_->fd) != 0) {
+            fail("sync " + active_->path.string());
+        }
+        std::filesystem::remove(segment->path);
+        segments_.erase(segment->number);
+        {
+            std::unique_lock index(index_mutex_);
+            for (const auto &[id, count]: dropped) {
+                const auto stale = superseded_.find(id);
+                if (stale != superseded_.end() && (stale->second -= std::min(stale->second, count)) == 0) {
+                    superseded_.erase(stale);
+                }
+            }
+        }
+        Loggers::App().log_info("प्रपञ्च — Prapancha: Compacted {} ({} of {} bytes kept).", segment->path.string(),
+                                frames.size(), data.size());
+    }
+
+} // namespace mehara::prapancha::persistence
@@ -4,7 +4,19 @@
 
 #include <prapancha/server/prapancha.h>
 
+#include <atomic>
+#include <cstdlib>
 #include <future>
+#include <latch>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
 
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/tcp.hpp>
@@ -13,15 +25,161 @@
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 
+#include <prapancha/server/compute.h>
 #include <prapancha/server/configuration.h>
+#include <prapancha/server/hashing_registry.h>
 #include <prapancha/server/http.h>
 #include <prapancha/server/listener.h>
 #include <prapancha/server/logger_registry.h>
+#include <prapancha/server/persistence_registry.h>
 #include <prapancha/server/routes.h>
+#include <prapancha/server/tls.h>
+#include <prapancha/server/uring/listener.h>
+#include <prapancha/server/uring/ring.h>
 
 namespace mehara::prapancha {
 
-    void run(int argc, char *argv[]) {
+    namespace {
+
+        void pin_to_core(std::thread &thread, const int core) {
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(core, &cpu_set);
+            if (const int rc = pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpu_set); rc != 0) {
+                Loggers::App().log_warn("प्रपञ्च — Prapancha: Failed to pin executor to core {} ({}).", core, rc);
+            }
+        }
+
+        /// Logs the hashing totals and joins the workers. Called once the compute pool has drained, so no handler is
+        /// still waiting on a hash.
+        void stop_hashing() {
+            const auto &metrics = HashingRegistry::service->metrics();
+            const std::uint64_t completed = metrics.completed.load(std::memory_order_relaxed);
+            const std::uint64_t nanoseconds = metrics.wait_nanoseconds.load(std::memory_order_relaxed);
+            Loggers::App().log_info("प्रपञ्च — Prapancha: {} hashes ({} refused, {} µs mean wait, {} µs peak wait, "
+                                    "{} peak queue depth).",
+                                    completed, metrics.rejected.load(std::memory_order_relaxed),
+                                    completed > 0 ? nanoseconds / completed / 1000 : 0,
+                                    metrics.peak_wait_nanoseconds.load(std::memory_order_relaxed) / 1000,
+                                    metrics.peak_queue_depth.load(std::memory_order_relaxed));
+            HashingRegistry::service.reset();
+        }
+
+        /// Runs one ring per pinned thread, each with its own listener. Only signal delivery stays on Asio.
+        ///
+        /// Handlers still on the compute pool at shutdown answer through sessions that refer to their ring, so each
+        /// ring thread stops accepting on a signal but keeps its ring alive until the compute and hashing pools have
+        /// drained.
+        ///
+        /// Returns false without serving when no ring could listen, so the caller can fall back to Asio. Rings that
+        /// fail alongside ones that started are logged and the rest keep serving.
+        bool serve_io_uring(const boost::asio::ip::tcp::endpoint &endpoint, const int thread_count) {
+            std::stop_source stop;
+            std::latch started(thread_count);
+            std::atomic<int> ready{0};
+            std::latch drained(1);
+            boost::asio::io_context signal_context(1);
+            boost::asio::signal_set signals(signal_context, SIGINT, SIGTERM);
+            signals.async_wait([&](const boost::system::error_code &ec, int signal_number) {
+                if (ec == boost::asio::error::operation_aborted)
+                    return;
+                Loggers::App().log_info("प्रपञ्च — Prapancha: Signal {} received.", signal_number);
+                stop.request_stop();
+            });
+            const int core_count = std::max<int>(1, std::thread::hardware_concurrency());
+            std::vector<std::thread> executors;
+            executors.reserve(thread_count);
+            for (auto i = 0; i < thread_count; ++i) {
+                // A ring is single-issuer, so it is built on the thread that drives it.
+                executors.emplace_back([i, &endpoint, &started, &ready, &drained, token = stop.get_token()] {
+                    uring::Listener<AppRouter> listener(endpoint);
+                    if (!listener.ready()) {
+                        Loggers::App().log_error("प्रपञ्च — Prapancha: io_uring ring {} failed to start.", i);
+                        started.count_down();
+                        return;
+                    }
+                    ready.fetch_add(1, std::memory_order_relaxed);
+                    started.count_down();
+                    std::stop_callback wake(token, [&listener] { listener.wake(); });
+                    listener.run(token);
+                    drained.wait();
+                });
+                pin_to_core(executors.back(), i % core_count);
+            }
+            started.wait();
+            const int serving = ready.load(std::memory_order_relaxed);
+            if (serving == 0) {
+                for (auto &thread: executors) {
+                    thread.join();
+                }
+                return false;
+            }
+            if (serving < thread_count) {
+                Loggers::App().log_warn("प्रपञ्च — Prapancha: Serving on {} of {} io_uring rings.", serving,
+                                        thread_count);
+            }
+            signal_context.run();
+            Loggers::App().log_info("प्रपञ्च — Prapancha: Signal acknowledged.");
+            compute::shutdown();
+            stop_hashing();
+            drained.count_down();
+            for (auto &thread: executors) {
+                if (thread.joinable())
+                    thread.join();
+            }
+            return true;
+        }
+
+        void log_tls_statistics() {
+            const auto &totals = tls::Context::statistics();
+            const std::uint64_t handshakes = totals.handshakes.load(std::memory_order_relaxed);
+            const std::uint64_t nanoseconds = totals.handshake_nanoseconds.load(std::memory_order_relaxed);
+            Loggers::App().log_info("प्रपञ्च — Prapancha: {} TLS handshakes ({} resumed, {} failed, {} µs mean).",
+                                    handshakes, totals.resumed.load(std::memory_order_relaxed),
+                                    totals.failures.load(std::memory_order_relaxed),
+                                    handshakes > 0 ? nanoseconds / handshakes / 1000 : 0);
+            Loggers::App().log_info("प्रपञ्च — Prapancha: kTLS offloaded {} sends and {} receives.",
+                                    totals.ktls_send.load(std::memory_order_relaxed),
+                                    totals.ktls_receive.load(std::memory_order_relaxed));
+        }
+
+        /// Logs the index size, the cache totals, and the group-commit totals of log-structured persistence.
+        void log_persistence_statistics() {
+            std::visit(
+                    [](const auto &indexed) {
+                        Loggers::App().log_info("प्रपञ्च — Prapancha: {} user identities indexed.", indexed.size());
+                        const auto &persistence = indexed.inner();
+                        if (const auto *cache = persistence.statistics()) {
+                            Loggers::App().log_info(
+                                    "प्रपञ्च — Prapancha: Cache served {} hits and {} known misses; {} misses, "
+                                    "{} evictions, {} invalidations.",
+                                    cache->hits.load(std::memory_order_relaxed),
+                                    cache->negative_hits.load(std::memory_order_relaxed),
+                                    cache->misses.load(std::memory_order_relaxed),
+                                    cache->evictions.load(std::memory_order_relaxed),
+                                    cache->invalidations.load(std::memory_order_relaxed));
+                        }
+                        if constexpr (requires { persistence.inner().metrics(); }) {
+                            const auto &metrics = persistence.inner().metrics();
+                            const std::uint64_t commits = metrics.commits.load(std::memory_order_relaxed);
+                            Loggers::App().log_info(
+                                    "प्रपञ्च — Prapancha: {} writes in {} commits ({} syncs, {} peak batch, {} µs "
+                                    "mean commit, {} µs peak commit).",
+                                    metrics.writes.load(std::memory_order_relaxed), commits,
+                                    metrics.syncs.load(std::memory_order_relaxed),
+                                    metrics.peak_batch.load(std::memory_order_relaxed),
+                                    commits > 0 ? metrics.commit_nanoseconds.load(std::memory_order_relaxed) /
+                                                          commits / 1000
+                                                : 0,
+                                    metrics.peak_commit_nanoseconds.load(std::memory_order_relaxed) / 1000);
+                        }
+                    },
+                    *PersistenceRegistry::user_identity_persistence);
+        }
+
+    } // namespace
+
+    int run(int argc, char *argv[]) {
         configuration::initialize(configuration::from_cli(argc, argv));
         const auto &config = *configuration::Active;
         int thread_count = config.network.thread_count;
@@ -31,30 +189,84 @@ namespace mehara::prapancha {
         const std::string root_path = std::filesystem::absolute(config.persistence.root_path).string();
         auto user_identity_path = std::filesystem::absolute(
                 root_path + "/" + std::string(UserIdentity<security::Argon2id>::model_name));
-        PersistenceRegistry::initialize_user_identity<security::Argon2id>(user_identity_path);
-        boost::asio::io_context io_context{thread_count};
+        // Built before any pool starts, so an unusable certificate or key stops the process before there is anything
+        // to shut down.
+        std::optional<tls::Context> tls;
+        if (config.is_tls()) {
+            if (!tls.emplace(config.network).ready()) {
+                Loggers::App().log_critical("प्रपञ्च — Prapancha: TLS is misconfigured; not starting.");
+                return EXIT_FAILURE;
+            }
+            if (config.is_io_uring()) {
+                Loggers::App().log_warn("प्रपञ्च — Prapancha: TLS is served on Asio; ignoring io_uring.");
+            }
+        }
+        PersistenceRegistry::initialize_user_identity<security::Argon2id>(user_identity_path, config.persistence);
+        compute::initialize(config.compute.thread_count);
+        HashingRegistry::initialize(config.hashing);
+        Loggers::App().log_info("प्रपञ्च — Prapancha: {} compute threads.", compute::thread_count());
         auto endpoint = boost::asio::ip::tcp::endpoint{boost::asio::ip::make_address(config.network.host),
                                                        static_cast<unsigned short>(config.network.port)};
-        std::make_shared<Listener<AppRouter>>(io_context, endpoint)->run();
+        if (config.is_io_uring() && !tls) {
+            if (uring::Ring::supported()) {
+                Loggers::App().log_info("प्रपञ्च — Prapancha: Starting on http://{}:{} ({} io_uring rings).",
+                                        config.network.host, config.network.port, thread_count);
+                if (serve_io_uring(endpoint, thread_count)) {
+                    log_persistence_statistics();
+                    Loggers::App().log_info("प्रपञ्च — Prapancha: Stopping.");
+                    return EXIT_SUCCESS;
+                }
+                Loggers::App().log_warn("प्रपञ्च — Prapancha: No io_uring ring started; falling back to Asio.");
+            } else {
+                Loggers::App().log_warn(
+                        "प्रपञ्च — Prapancha: io_uring unavailable on this kernel; falling back to Asio.");
+            }
+        }
+        // Shared execution runs every executor thread on one io_context. Sharded execution gives each thread its own
+        // io_context and acceptor, so a connection never leaves the core that accepted it.
+        const int shard_count = config.is_sharded() ? thread_count : 1;
+        std::vector<std::unique_ptr<boost::asio::io_context>> io_contexts;
+        io_contexts.reserve(shard_count);
+        for (auto i = 0; i < shard_count; ++i) {
+            io_contexts.emplace_back(std::make_unique<boost::asio::io_context>(config.is_sharded() ? 1 : thread_count));
+            const auto listener = std::make_shared<Listener<AppRouter>>(
+                    *io_contexts.back(), endpoint, config.network.execution, tls ? &*tls : nullptr);
+            if (!listener->ready()) {
+                Loggers::App().log_critical("प्रपञ्च — Prapancha: Cannot listen on {}:{}; not starting.",
+                                            config.network.host, config.network.port);
+                compute::shutdown();
+                stop_hashing();
+                return EXIT_FAILURE;
+            }
+            listener->run();
+        }
         std::promise<int> shutdown_promised;
         auto shutdown_future = shutdown_promised.get_future();
-        boost::asio::signal_set signals(io_context, SIGINT, SIGTERM);
+        boost::asio::signal_set signals(*io_contexts.front(), SIGINT, SIGTERM);
         signals.async_wait([&](const boost::system::error_code &ec, int signal_number) {
             if (ec == boost::asio::error::operation_aborted)
                 return;
             Loggers::App().log_info("प्रपञ्च — Prapancha: Signal {} received.", signal_number);
-            io_context.stop();
+            for (const auto &io_context: io_contexts) {
+                io_context->stop();
+            }
             static std::atomic<bool> signaled{false};
             if (!signaled.exchange(true)) {
                 shutdown_promised.set_value(signal_number);
             }
         });
-        Loggers::App().log_info("प्रपञ्च — Prapancha: Starting on http://{}:{} ({} executors).", config.network.host,
-                                config.network.port, thread_count);
+        Loggers::App().log_info("प्रपञ्च — Prapancha: Starting on {}://{}:{} ({} executors, {} shards).",
+                                tls ? "https" : "http", config.network.host, config.network.port, thread_count,
+                                shard_count);
+        const int core_count = std::max<int>(1, std::thread::hardware_concurrency());
         std::vector<std::thread> executors;
         executors.reserve(thread_count);
         for (auto i = 0; i < thread_count; ++i) {
+            auto &io_context = *io_contexts[i % shard_count];
             executors.emplace_back([&io_context] { io_context.run(); });
+            if (config.is_sharded()) {
+                pin_to_core(executors.back(), i % core_count);
+            }
         }
         int signal_number = shutdown_future.get();
         Loggers::App().log_info("प्रपञ्च — Prapancha: Signal {} acknowledged.", signal_number);
@@ -62,7 +274,14 @@ namespace mehara::prapancha {
             if (thread.joinable())
                 thread.join();
         }
+        compute::shutdown();
+        stop_hashing();
+        log_persistence_statistics();
+        if (tls) {
+            log_tls_statistics();
+        }
         Loggers::App().log_info("प्रपञ्च — Prapancha: Stopping.");
+        return EXIT_SUCCESS;
     }
 
 } // namespace mehara::prapancha
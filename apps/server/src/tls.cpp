@@ -0,0 +1,141 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <prapancha/server/tls.h>
+
+#include <format>
+#include <string>
+
+#include <openssl/bio.h>
+
+#include <prapancha/server/logger_registry.h>
+
+namespace mehara::prapancha::tls {
+
+    namespace {
+
+        constexpr unsigned char session_id_context[] = "prapancha";
+
+        /// ALPN protocols in server preference order, in wire format.
+        constexpr unsigned char protocols[] = {2, 'h', '2', 8, 'h', 't', 't', 'p', '/', '1', '.', '1'};
+
+        int select_protocol(SSL *, const unsigned char **out, unsigned char *out_length, const unsigned char *in,
+                            const unsigned int in_length, void *) {
+            unsigned char *selected = nullptr;
+            if (SSL_select_next_proto(&selected, out_length, protocols, sizeof(protocols), in, in_length) !=
+                OPENSSL_NPN_NEGOTIATED) {
+                return SSL_TLSEXT_ERR_NOACK;
+            }
+            *out = selected;
+            return SSL_TLSEXT_ERR_OK;
+        }
+
+        [[nodiscard]] std::string last_error() {
+            char message[256];
+            ERR_error_string_n(ERR_get_error(), message, sizeof(message));
+            return message;
+        }
+
+    } // namespace
+
+    Context::Context(const configuration::Configuration::Network &network) {
+        SSL_CTX *context = SSL_CTX_new(TLS_server_method());
+        if (context == nullptr) {
+            Loggers::App().log_error("प्रपञ्च — Prapancha: TLS context unavailable: {}", last_error());
+            return;
+        }
+        context_.reset(context);
+        SSL_CTX_set_min_proto_version(context, TLS1_2_VERSION);
+        SSL_CTX_set_options(context, SSL_OP_ENABLE_KTLS | SSL_OP_NO_RENEGOTIATION | SSL_OP_CIPHER_SERVER_PREFERENCE);
+        // The kernel record layer implements AES-GCM and ChaCha20-Poly1305; TLS 1.2 is held to those suites so that
+        // every connection stays eligible for offload. TLS 1.3 suites are all AEAD already.
+        SSL_CTX_set_cipher_list(context, "ECDHE+AESGCM:ECDHE+CHACHA20");
+        SSL_CTX_set_mode(context, SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER | SSL_MODE_RELEASE_BUFFERS);
+        SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_sess_set_cache_size(context, network.tls_session_cache);
+        SSL_CTX_set_session_id_context(context, session_id_context, sizeof(session_id_context) - 1);
+        SSL_CTX_set_num_tickets(context, network.tls_tickets);
+        SSL_CTX_set_alpn_select_cb(context, &select_protocol, nullptr);
+        if (SSL_CTX_use_certificate_chain_file(context, network.tls_certificate.c_str()) != 1 ||
+            SSL_CTX_use_PrivateKey_file(context, network.tls_private_key.c_str(), SSL_FILETYPE_PEM) != 1 ||
+            SSL_CTX_check_private_key(context) != 1) {
+            Loggers::App().log_error("प्रपञ्च — Prapancha: TLS certificate {} with key {} unusable: {}",
+                                     network.tls_certificate, network.tls_private_key, last_error());
+            context_.reset();
+        }
+    }
+
+    void Context::record(const SSL *ssl, const std::chrono::steady_clock::duration elapsed,
+                         const bool succeeded) noexcept {
+        auto &totals = statistics();
+        if (!succeeded) {
+            totals.failures.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const bool resumed = SSL_session_reused(ssl) == 1;
+        const bool ktls_send = BIO_get_ktls_send(SSL_get_wbio(ssl));
+        const bool ktls_receive = BIO_get_ktls_recv(SSL_get_rbio(ssl));
+        const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        totals.handshakes.fetch_add(1, std::memory_order_relaxed);
+        totals.resumed.fetch_add(resumed ? 1 : 0, std::memory_order_relaxed);
+        totals.ktls_send.fetch_add(ktls_send ? 1 : 0, std::memory_order_relaxed);
+        totals.ktls_receive.fetch_add(ktls_receive ? 1 : 0, std::memory_order_relaxed);
+        totals.handshake_nanoseconds.fetch_add(static_cast<std::uint64_t>(nanoseconds), std::memory_order_relaxed);
+        Loggers::App().log_debug([&] {
+            return std::format("प्रपञ्च — Prapancha: {} {} handshake with {} in {} µs (kTLS send {}, receive {}).",
+                               resumed ? "Resumed" : "Full", SSL_get_version(ssl), SSL_get_cipher_name(ssl),
+                               nanoseconds / 1000, ktls_send, ktls_receive);
+        });
+    }
+
+    Context::Statistics &Context::statistics() noexcept {
+        static Statistics totals;
+        return totals;
+    }
+
+    Stream::Stream(boost::asio::ip::tcp::socket &&socket, const Context &context) :
+        state_(std::make_shared<State>(std::move(socket), SSL_new(context.native()))) {
+        boost::system::error_code ignored_ec;
+        state_->socket.native_non_blocking(true, ignored_ec);
+        if (auto *ssl = state_->ssl.get()) {
+            SSL_set_fd(ssl, state_->socket.native_handle());
+            SSL_set_accept_state(ssl);
+        }
+    }
+
+    bool Stream::zero_copy() const noexcept { return BIO_get_ktls_send(SSL_get_wbio(state_->ssl.get())); }
+
+    std::string_view Stream::alpn() const noexcept {
+        const unsigned char *data = nullptr;
+        unsigned int length = 0;
+        SSL_get0_alpn_selected(state_->ssl.get(), &data, &length);
+        return {reinterpret_cast<const char *>(data), length};
+    }
+
+    void Stream::expires_after(const std::chrono::steady_clock::duration expiry) {
+        state_->timer.expires_after(expiry);
+        // Shutting the socket down rather than closing it keeps the descriptor OpenSSL holds from being reused.
+        state_->timer.async_wait([state = std::weak_ptr<State>(state_)](const boost::system::error_code &ec) {
+            const auto locked = state.lock();
+            if (ec || !locked) {
+                return;
+            }
+            boost::system::error_code ignored_ec;
+            locked->socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored_ec);
+            locked->socket.cancel(ignored_ec);
+        });
+    }
+
+    void Stream::expires_never() { state_->timer.cancel(); }
+
+    void Stream::close_notify() noexcept {
+        auto *ssl = state_->ssl.get();
+        if (ssl == nullptr || SSL_is_init_finished(ssl) != 1) {
+            return;
+        }
+        ERR_clear_error();
+        SSL_shutdown(ssl);
+    }
+
+} // namespace mehara::prapancha::tls
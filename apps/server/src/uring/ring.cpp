@@ -0,0 +1,191 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <prapancha/server/uring/ring.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <netinet/in.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <prapancha/server/logger_registry.h>
+
+namespace mehara::prapancha::uring {
+
+    namespace {
+
+        /// A ring serves exactly one thread, so the kernel can skip submitter locking and run completion work only
+        /// when the owner asks for events. Kernels before 6.1 reject these flags and get a default ring instead.
+        int initialize(io_uring &ring, const unsigned depth) noexcept {
+            io_uring_params params{};
+            params.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+            if (const int rv = io_uring_queue_init_params(depth, &ring, &params); rv != -EINVAL) {
+                return rv;
+            }
+            params = {};
+            return io_uring_queue_init_params(depth, &ring, &params);
+        }
+
+    } // namespace
+
+    Ring::Ring() {
+        if (const int rv = initialize(ring_, entries); rv < 0) {
+            Loggers::App().log_error("प्रपञ्च — Prapancha: io_uring setup failed [{}]: {}", -rv, std::strerror(-rv));
+            return;
+        }
+        initialized_ = true;
+        if (const int rv = io_uring_register_files_sparse(&ring_, registered_files); rv < 0) {
+            Loggers::App().log_error("प्रपञ्च — Prapancha: io_uring file table unavailable [{}]: {}", -rv,
+                                     std::strerror(-rv));
+            return;
+        }
+        int rv = 0;
+        buffers_ = io_uring_setup_buf_ring(&ring_, buffer_count, buffer_group, 0, &rv);
+        if (!buffers_) {
+            Loggers::App().log_error("प्रपञ्च — Prapancha: io_uring buffer ring unavailable [{}]: {}", -rv,
+                                     std::strerror(-rv));
+            return;
+        }
+        storage_ = std::make_unique_for_overwrite<char[]>(static_cast<std::size_t>(buffer_count) * buffer_size);
+        for (unsigned id = 0; id < buffer_count; ++id) {
+            io_uring_buf_ring_add(buffers_, storage_.get() + static_cast<std::size_t>(id) * buffer_size, buffer_size,
+                                  static_cast<unsigned short>(id), io_uring_buf_ring_mask(buffer_count),
+                                  static_cast<int>(id));
+        }
+        io_uring_buf_ring_advance(buffers_, static_cast<int>(buffer_count));
+        event_fd_ = ::eventfd(0, EFD_CLOEXEC);
+        if (event_fd_ < 0) {
+            Loggers::App().log_error("प्रपञ्च — Prapancha: eventfd failed [{}]: {}", errno, std::strerror(errno));
+            return;
+        }
+        owner_ = std::this_thread::get_id();
+        arm_wakeup();
+        ready_ = true;
+    }
+
+    Ring::~Ring() {
+        if (buffers_) {
+            io_uring_free_buf_ring(&ring_, buffers_, buffer_count, buffer_group);
+        }
+        if (initialized_) {
+            io_uring_queue_exit(&ring_);
+        }
+        if (event_fd_ >= 0) {
+            ::close(event_fd_);
+        }
+    }
+
+    bool Ring::supported() noexcept {
+        io_uring probe{};
+        if (io_uring_queue_init(8, &probe, 0) < 0) {
+            return false;
+        }
+        int rv = 0;
+        // Provided buffer rings and multishot accept arrived together in 5.19.
+        auto *buffers = io_uring_setup_buf_ring(&probe, 8, buffer_group, 0, &rv);
+        if (buffers) {
+            io_uring_free_buf_ring(&probe, buffers, 8, buffer_group);
+        }
+        io_uring_queue_exit(&probe);
+        return buffers != nullptr;
+    }
+
+    bool Ring::ready() const noexcept { return ready_; }
+
+    io_uring_sqe *Ring::prepare(Completion &completion) {
+        io_uring_sqe *sqe = io_uring_get_sqe(&ring_);
+        while (!sqe) {
+            io_uring_submit(&ring_);
+            sqe = io_uring_get_sqe(&ring_);
+        }
+        io_uring_sqe_set_data(sqe, &completion);
+        return sqe;
+    }
+
+    std::span<const char> Ring::buffer(const std::uint32_t flags, const std::int32_t length) const noexcept {
+        const std::size_t id = flags >> IORING_CQE_BUFFER_SHIFT;
+        return {storage_.get() + id * buffer_size, static_cast<std::size_t>(length)};
+    }
+
+    void Ring::release(const std::uint32_t flags) noexcept {
+        const auto id = static_cast<unsigned short>(flags >> IORING_CQE_BUFFER_SHIFT);
+        io_uring_buf_ring_add(buffers_, storage_.get() + static_cast<std::size_t>(id) * buffer_size, buffer_size, id,
+                              io_uring_buf_ring_mask(buffer_count), 0);
+        io_uring_buf_ring_advance(buffers_, 1);
+    }
+
+    void Ring::dispatch(std::move_only_function<void()> &&task) {
+        if (std::this_thread::get_id() == owner_) {
+            return task();
+        }
+        {
+            std::lock_guard lock(posted_mutex_);
+            posted_.push_back(std::move(task));
+        }
+        wake();
+    }
+
+    void Ring::wake() noexcept {
+        constexpr std::uint64_t one = 1;
+        [[maybe_unused]] const auto written = ::write(event_fd_, &one, sizeof(one));
+    }
+
+    void Ring::run(const std::stop_token token) {
+        while (!token.stop_requested()) {
+            if (const int rv = io_uring_submit_and_wait(&ring_, 1); rv < 0 && rv != -EINTR) {
+                Loggers::App().log_error("प्रपञ्च — Prapancha: io_uring wait failed [{}]: {}", -rv,
+                                         std::strerror(-rv));
+                return;
+            }
+            unsigned head = 0;
+            unsigned seen = 0;
+            io_uring_cqe *cqe = nullptr;
+            io_uring_for_each_cqe(&ring_, head, cqe) {
+                ++seen;
+                if (auto *completion = static_cast<Completion *>(io_uring_cqe_get_data(cqe))) {
+                    completion->complete(cqe->res, cqe->flags);
+                }
+            }
+            io_uring_cq_advance(&ring_, seen);
+        }
+    }
+
+    void Ring::arm_wakeup() {
+        io_uring_prep_read(prepare(wakeup_), event_fd_, &wakeup_value_, sizeof(wakeup_value_), 0);
+    }
+
+    void Ring::on_wakeup(std::int32_t, std::uint32_t) {
+        {
+            std::lock_guard lock(posted_mutex_);
+            running_.swap(posted_);
+        }
+        for (auto &task: running_) {
+            task();
+        }
+        running_.clear();
+        arm_wakeup();
+    }
+
+    int open_listener(const boost::asio::ip::tcp::endpoint &endpoint) noexcept {
+        const int fd = ::socket(endpoint.protocol().family(), SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            Loggers::App().log_error("प्रपञ्च — Prapancha: socket failed [{}]: {}", errno, std::strerror(errno));
+            return -1;
+        }
+        constexpr int enabled = 1;
+        // Every ring binds its own listener to the same endpoint; the kernel balances connections across them.
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enabled, sizeof(enabled));
+        if (::bind(fd, endpoint.data(), static_cast<socklen_t>(endpoint.size())) < 0 || ::listen(fd, SOMAXCONN) < 0) {
+            Loggers::App().log_error("प्रपञ्च — Prapancha: listen failed [{}]: {}", errno, std::strerror(errno));
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+} // namespace mehara::prapancha::uring
@@ -0,0 +1,43 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <prapancha/server/codec/base64url_codec.h>
+
+namespace {
+
+    using Codec = mehara::prapancha::codec::Base64UrlCodec<std::vector<std::uint8_t>>;
+
+    bool expect(const std::string_view encoded, const std::optional<std::vector<std::uint8_t>> &expected) {
+        const auto decoded = Codec::decode(encoded);
+        const bool passed = decoded == expected && (!decoded || Codec::encode(*decoded) == encoded);
+        std::printf("%s \"%.*s\": %s, %zu bytes\n", passed ? "PASS" : "FAIL", static_cast<int>(encoded.size()),
+                    encoded.data(), decoded ? "decoded" : "rejected", decoded ? decoded->size() : 0);
+        return passed;
+    }
+
+} // namespace
+
+int main() {
+    bool passed = true;
+    passed &= expect("", std::vector<std::uint8_t>{});
+    // Unpadded lengths of 4k+2 and 4k+3 decode to one and two trailing bytes past the last full group.
+    passed &= expect("AAAAAA", std::vector<std::uint8_t>{0, 0, 0, 0});
+    passed &= expect("AAAAAAA", std::vector<std::uint8_t>{0, 0, 0, 0, 0});
+    passed &= expect("_-8", std::vector<std::uint8_t>{0xFF, 0xEF});
+    // A SETTINGS payload: SETTINGS_MAX_CONCURRENT_STREAMS = 100, SETTINGS_INITIAL_WINDOW_SIZE = 65535.
+    passed &= expect("AAMAAABkAAQAAP__", std::vector<std::uint8_t>{0x00, 0x03, 0x00, 0x00, 0x00, 0x64, 0x00, 0x04,
+                                                                    0x00, 0x00, 0xFF, 0xFF});
+    passed &= expect("A", std::nullopt);
+    passed &= expect("AAAAA", std::nullopt);
+    passed &= expect("AA==", std::nullopt);
+    passed &= expect("AA+/", std::nullopt);
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
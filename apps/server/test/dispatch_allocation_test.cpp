@@ -0,0 +1,139 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string_view>
+
+#include <prapancha/server/arena.h>
+#include <prapancha/server/controller/controller_provider.h>
+#include <prapancha/server/http.h>
+#include <prapancha/server/responder.h>
+#include <prapancha/server/router.h>
+
+namespace {
+
+    std::atomic<bool> counting{false};
+    std::atomic<std::size_t> allocations{0};
+
+    void *allocate(const std::size_t size, const std::size_t alignment) {
+        if (counting.load(std::memory_order_relaxed)) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        const std::size_t bytes = ((size == 0 ? 1 : size) + alignment - 1) / alignment * alignment;
+        if (void *memory = std::aligned_alloc(alignment, bytes)) {
+            return memory;
+        }
+        throw std::bad_alloc();
+    }
+
+} // namespace
+
+// The remaining replaceable forms (array, nothrow, sized) forward to these by default.
+void *operator new(const std::size_t size) { return allocate(size, alignof(std::max_align_t)); }
+
+void *operator new(const std::size_t size, const std::align_val_t alignment) {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+
+void operator delete(void *memory, std::align_val_t) noexcept { std::free(memory); }
+
+namespace mehara::prapancha {
+
+    namespace {
+
+        /// Stands in for a transport session: the responder captures a shared pointer to it and a sequence number,
+        /// exactly as Session, uring::Session and Http2Session do.
+        struct Connection {
+            http::Status status = http::Status::NotImplemented;
+            std::size_t answered = 0;
+        };
+
+        using TestRouter =
+                Router<Route<"/", http::Method::Get, ControllerProvider::root_controller>,
+                       Route<"/api/v1/status", http::Method::Get, ControllerProvider::status_controller>,
+                       Route<"/api/v1/status/{probe}", http::Method::Get, ControllerProvider::status_controller>>;
+
+        /// Dispatches one request and returns the number of global allocations made while doing so.
+        std::size_t dispatch(const std::shared_ptr<Connection> &connection, const http::Method method,
+                             const std::string_view target) {
+            Arena arena(4 * 1024);
+            const http::Fields fields{std::pmr::polymorphic_allocator<char>(&arena)};
+            const std::size_t sequence = connection->answered;
+            http::Responder send = [connection, sequence](http::Response &&response) {
+                connection->status = response.status;
+                connection->answered = sequence + 1;
+            };
+            http::RequestView request{.method = method, .target = target, .fields = &fields, .arena = &arena};
+            allocations.store(0, std::memory_order_relaxed);
+            counting.store(true, std::memory_order_relaxed);
+            TestRouter::dispatch(std::move(request), std::move(send));
+            counting.store(false, std::memory_order_relaxed);
+            return allocations.load(std::memory_order_relaxed);
+        }
+
+        bool expect(const std::shared_ptr<Connection> &connection, const http::Method method,
+                    const std::string_view target, const http::Status status) {
+            const std::size_t before = connection->answered;
+            const std::size_t count = dispatch(connection, method, target);
+            const bool passed = count == 0 && connection->answered == before + 1 && connection->status == status;
+            std::printf("%s %s %.*s: %zu allocations, status %d\n", passed ? "PASS" : "FAIL",
+                        http::get_traits(method).name.data(), static_cast<int>(target.size()), target.data(), count,
+                        static_cast<int>(connection->status));
+            return passed;
+        }
+
+        /// A request no route takes admits no body, so transports answer it with 404 or 405 rather than 413.
+        bool unrouted(const http::Method method, const std::string_view target) {
+            const http::BodyLimit limit = TestRouter::body_limit(method, target);
+            const bool passed = !TestRouter::routed(method, target) && limit.bytes == 0 && !limit.streaming;
+            std::printf("%s unrouted %.*s: limit %llu bytes\n", passed ? "PASS" : "FAIL",
+                        static_cast<int>(target.size()), target.data(), static_cast<unsigned long long>(limit.bytes));
+            return passed;
+        }
+
+        /// A header sent more than once is joined into the arena, so reading it costs no global allocation either.
+        bool joins() {
+            Arena arena(4 * 1024);
+            http::Fields fields{std::pmr::polymorphic_allocator<char>(&arena)};
+            fields.insert(boost::beast::http::field::accept, "text/plain");
+            fields.insert(boost::beast::http::field::accept, "application/json");
+            const http::RequestView request{.fields = &fields, .arena = &arena};
+            allocations.store(0, std::memory_order_relaxed);
+            counting.store(true, std::memory_order_relaxed);
+            const auto accept = request.header(boost::beast::http::field::accept);
+            counting.store(false, std::memory_order_relaxed);
+            const std::size_t count = allocations.load(std::memory_order_relaxed);
+            const bool passed = count == 0 && accept == "text/plain, application/json";
+            std::printf("%s repeated header: %zu allocations\n", passed ? "PASS" : "FAIL", count);
+            return passed;
+        }
+
+    } // namespace
+
+} // namespace mehara::prapancha
+
+int main() {
+    using namespace mehara::prapancha;
+    const auto connection = std::make_shared<Connection>();
+    // Controllers are built on first use; warm each route up so only the steady-state path is counted.
+    dispatch(connection, http::Method::Get, "/");
+    dispatch(connection, http::Method::Get, "/api/v1/status");
+    bool passed = true;
+    passed &= expect(connection, http::Method::Get, "/", http::Status::Ok);
+    passed &= expect(connection, http::Method::Get, "/api/v1/status", http::Status::Ok);
+    passed &= expect(connection, http::Method::Get, "/api/v1/status/ready?verbose=1", http::Status::Ok);
+    passed &= expect(connection, http::Method::Post, "/api/v1/status", http::Status::MethodNotAllowed);
+    passed &= unrouted(http::Method::Post, "/nowhere");
+    passed &= unrouted(http::Method::Post, "/api/v1/status");
+    passed &= TestRouter::routed(http::Method::Get, "/api/v1/status/ready");
+    passed &= joins();
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
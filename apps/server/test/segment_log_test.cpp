@@ -0,0 +1,93 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <prapancha/server/persistence/segment_log.h>
+#include <prapancha/server/uuid.h>
+
+namespace {
+
+    using mehara::prapancha::UUID;
+    using mehara::prapancha::persistence::SegmentLog;
+
+    std::uintmax_t log_size(const std::filesystem::path &directory) {
+        std::uintmax_t total = 0;
+        for (const auto &entry: std::filesystem::directory_iterator(directory)) {
+            total += entry.file_size();
+        }
+        return total;
+    }
+
+    bool report(const bool passed, const char *what) {
+        std::printf("%s %s\n", passed ? "PASS" : "FAIL", what);
+        return passed;
+    }
+
+} // namespace
+
+/// Erased ids leave tombstones behind. Once compaction has removed every older version of those ids, the
+/// tombstones must go too instead of being copied into the active segment on every pass.
+int main() {
+    const auto directory = std::filesystem::temp_directory_path() / ("segment_log_test_" + std::to_string(::getpid()));
+    SegmentLog::Options options;
+    options.segment_size = 4096;
+    options.compaction_interval = std::chrono::milliseconds{0};
+    options.durability = SegmentLog::Durability::None;
+    const std::string payload(200, 'x');
+    std::vector<UUID> anchored(16);
+    std::vector<UUID> erased(64);
+    std::vector<UUID> kept(16);
+    bool passed = true;
+    {
+        SegmentLog log(directory, options);
+        // Never rewritten, so the oldest segment stays live and is never compacted.
+        for (UUID &id: anchored) {
+            id = UUID::generate();
+            log.put(id, payload);
+        }
+        for (UUID &id: erased) {
+            id = UUID::generate();
+            log.put(id, payload);
+        }
+        for (const UUID &id: erased) {
+            log.erase(id);
+        }
+        std::vector<std::uintmax_t> sizes;
+        for (int round = 0; round < 4; ++round) {
+            // Rewriting the kept ids seals the segments the previous pass appended to, so they can be compacted.
+            for (UUID &id: kept) {
+                if (round == 0) {
+                    id = UUID::generate();
+                }
+                log.put(id, payload);
+            }
+            log.compact();
+            sizes.push_back(log_size(directory));
+            std::printf("round %d: %ju bytes\n", round, sizes.back());
+        }
+        passed &= report(sizes.back() < sizes.front(), "repeated compaction shrinks the log");
+        passed &= report(sizes[2] == sizes[3], "the log settles once only live frames remain");
+        passed &= report(log.ids().size() == anchored.size() + kept.size(), "only the kept ids are live");
+    }
+    {
+        SegmentLog log(directory, options);
+        bool absent = true;
+        for (const UUID &id: erased) {
+            absent &= !log.get(id).has_value();
+        }
+        passed &= report(absent && log.ids().size() == anchored.size() + kept.size(),
+                         "erased ids stay erased after reopening");
+    }
+    std::filesystem::remove_all(directory);
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,36 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SECURITY_ALGORITHMS_H_
+#define PRAPANCHA_SECURITY_ALGORITHMS_H_
+
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+
+/// @brief Provider algorithms fetched once per process, and contexts reused once per thread.
+///
+/// An explicit fetch walks the provider store under a global lock, and the implicit fetches behind EVP_Q_digest and
+/// EVP_aes_256_gcm() do the same on every call. Fetching each algorithm once removes that lock from every call, and
+/// a thread's contexts are reused rather than allocated per call. Resetting a digest or KDF context still frees the
+/// provider's state, which the next init rebuilds; only the cipher context keeps it across calls.
+namespace mehara::prapancha::security::algorithms {
+
+    /// Fetched on first use and kept for the life of the process; nullptr if no provider offers the algorithm.
+    [[nodiscard]] EVP_KDF *argon2id() noexcept;
+    [[nodiscard]] EVP_MD *sha256() noexcept;
+    [[nodiscard]] EVP_CIPHER *aes_256_gcm() noexcept;
+
+    /// The calling thread's context, reset and ready for an init call. It stays owned by the thread and must not be
+    /// freed or held across another call to the same accessor. Nullptr only if allocation failed.
+    [[nodiscard]] EVP_KDF_CTX *kdf_context() noexcept;
+    [[nodiscard]] EVP_MD_CTX *digest_context() noexcept;
+
+    /// The calling thread's cipher context, bound to AES-256-GCM and never reset. Init it with a null cipher and only
+    /// a key and IV, so the provider's cipher state is reused. Same ownership rules as above; nullptr only if
+    /// allocation or binding failed.
+    [[nodiscard]] EVP_CIPHER_CTX *cipher_context() noexcept;
+
+} // namespace mehara::prapancha::security::algorithms
+
+#endif // PRAPANCHA_SECURITY_ALGORITHMS_H_
@@ -5,9 +5,16 @@
 #ifndef PRAPANCHA_SECURITY_CRYPTER_H_
 #define PRAPANCHA_SECURITY_CRYPTER_H_
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <expected>
+#include <memory>
+#include <span>
 #include <vector>
 
+#include <openssl/evp.h>
+
 #include <prapancha/security/error.h>
 
 namespace mehara::prapancha::security {
@@ -19,8 +26,67 @@ namespace mehara::prapancha::security {
         bool operator==(const Aes256GcmBinding &) const = default;
     };
 
+    /// IV and tag of a ciphertext the caller keeps in its own buffer.
+    struct Aes256GcmSeal {
+        std::array<uint8_t, 12> iv;
+        std::array<uint8_t, 16> tag;
+        bool operator==(const Aes256GcmSeal &) const = default;
+    };
+
+    /// Aes256GcmEncryptor Class
+    ///
+    /// Encrypts a payload in chunks, for payloads too large to hold at once. Associated data goes in before the
+    /// first chunk; GCM is a stream mode, so every chunk produces exactly as many bytes as it consumes. The encryptor
+    /// owns its own cipher context, so it may be kept across calls and moved between threads, but not shared.
+    class Aes256GcmEncryptor final {
+        std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)> ctx_;
+        Aes256GcmSeal seal_{};
+
+        Aes256GcmEncryptor() noexcept;
+
+    public:
+        /// Starts an encryption under `key` with a fresh random IV.
+        static std::expected<Aes256GcmEncryptor, Error> create(std::span<const uint8_t> key);
+
+        /// Adds associated data: authenticated by the tag but not encrypted. Only valid before the first update().
+        std::expected<void, Error> authenticate(std::span<const uint8_t> aad);
+
+        /// Encrypts `plain` into the first `plain.size()` bytes of `cipher`, which may be `plain` itself.
+        std::expected<void, Error> update(std::span<const uint8_t> plain, std::span<uint8_t> cipher);
+
+        /// Completes the encryption and returns the IV and tag to store beside the ciphertext.
+        std::expected<Aes256GcmSeal, Error> finish();
+    };
+
+    /// Aes256GcmDecryptor Class
+    ///
+    /// The decrypting counterpart of Aes256GcmEncryptor. Plaintext from update() is unauthenticated until finish()
+    /// succeeds, and must be discarded if it fails.
+    class Aes256GcmDecryptor final {
+        std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)> ctx_;
+
+        Aes256GcmDecryptor() noexcept;
+
+    public:
+        static std::expected<Aes256GcmDecryptor, Error> create(std::span<const uint8_t> key,
+                                                               std::span<const uint8_t> iv);
+
+        std::expected<void, Error> authenticate(std::span<const uint8_t> aad);
+
+        std::expected<void, Error> update(std::span<const uint8_t> cipher, std::span<uint8_t> plain);
+
+        /// Checks `tag` against everything decrypted and authenticated so far.
+        std::expected<void, Error> finish(std::span<const uint8_t> tag);
+    };
+
     struct Aes256Gcm {
         using Binding = Aes256GcmBinding;
+        using Seal = Aes256GcmSeal;
+        using Encryptor = Aes256GcmEncryptor;
+        using Decryptor = Aes256GcmDecryptor;
+        static constexpr std::size_t key_length = 32;
+        static constexpr std::size_t iv_length = std::tuple_size_v<decltype(Seal::iv)>;
+        static constexpr std::size_t tag_length = std::tuple_size_v<decltype(Seal::tag)>;
     };
 
     class Crypter {
@@ -29,21 +95,63 @@ namespace mehara::prapancha::security {
 
         template<typename Algorithm>
         static std::expected<typename Algorithm::Binding, Error> encrypt(const std::vector<uint8_t> &plain,
-                                                                         const std::vector<uint8_t> &key) {
-            return encrypt(plain, key, Algorithm{});
+                                                                         const std::vector<uint8_t> &key,
+                                                                         std::span<const uint8_t> aad = {}) {
+            return encrypt(plain, key, aad, Algorithm{});
         }
 
         template<typename Algorithm>
         static std::expected<std::vector<uint8_t>, Error> decrypt(const typename Algorithm::Binding &binding,
-                                                                  const std::vector<uint8_t> &key) {
-            return decrypt(binding, key, Algorithm{});
+                                                                  const std::vector<uint8_t> &key,
+                                                                  std::span<const uint8_t> aad = {}) {
+            return decrypt(binding, key, aad, Algorithm{});
+        }
+
+        /// Encrypts `plain` into `cipher`, which must be at least as long. Passing the same buffer for both encrypts in
+        /// place; otherwise they must not overlap. Re-keys the calling thread's cipher context rather than building
+        /// new cipher state for each call.
+        template<typename Algorithm>
+        static std::expected<typename Algorithm::Seal, Error> encrypt(std::span<const uint8_t> plain,
+                                                                      std::span<uint8_t> cipher,
+                                                                      std::span<const uint8_t> key,
+                                                                      std::span<const uint8_t> aad = {}) {
+            return encrypt(plain, cipher, key, aad, Algorithm{});
+        }
+
+        /// Decrypts `cipher` into `plain`, with the same aliasing rules as encrypt(). On failure `plain` holds
+        /// unauthenticated bytes and must be discarded.
+        template<typename Algorithm>
+        static std::expected<void, Error> decrypt(const typename Algorithm::Seal &seal,
+                                                  std::span<const uint8_t> cipher, std::span<uint8_t> plain,
+                                                  std::span<const uint8_t> key, std::span<const uint8_t> aad = {}) {
+            return decrypt(seal, cipher, plain, key, aad, Algorithm{});
+        }
+
+        /// Starts a streaming encryption; see Aes256GcmEncryptor.
+        template<typename Algorithm>
+        static std::expected<typename Algorithm::Encryptor, Error> encryptor(std::span<const uint8_t> key) {
+            return Algorithm::Encryptor::create(key);
+        }
+
+        template<typename Algorithm>
+        static std::expected<typename Algorithm::Decryptor, Error> decryptor(std::span<const uint8_t> key,
+                                                                             std::span<const uint8_t> iv) {
+            return Algorithm::Decryptor::create(key, iv);
         }
 
     private:
         static std::expected<Aes256GcmBinding, Error> encrypt(const std::vector<uint8_t> &,
-                                                              const std::vector<uint8_t> &, Aes256Gcm);
+                                                              const std::vector<uint8_t> &, std::span<const uint8_t>,
+                                                              Aes256Gcm);
         static std::expected<std::vector<uint8_t>, Error> decrypt(const Aes256GcmBinding &,
-                                                                  const std::vector<uint8_t> &, Aes256Gcm);
+                                                                  const std::vector<uint8_t> &,
+                                                                  std::span<const uint8_t>, Aes256Gcm);
+        static std::expected<Aes256GcmSeal, Error> encrypt(std::span<const uint8_t>, std::span<uint8_t>,
+                                                           std::span<const uint8_t>, std::span<const uint8_t>,
+                                                           Aes256Gcm);
+        static std::expected<void, Error> decrypt(const Aes256GcmSeal &, std::span<const uint8_t>,
+                                                  std::span<uint8_t>, std::span<const uint8_t>,
+                                                  std::span<const uint8_t>, Aes256Gcm);
     };
 
 } // namespace mehara::prapancha::security
@@ -16,8 +16,13 @@ namespace mehara::prapancha::security {
 
     class Error final {
     public:
+        /// Work was refused because the service was saturated; nothing was attempted and it may be retried.
+        static constexpr unsigned long Busy = ~0UL;
+
         explicit constexpr Error(const unsigned long code) noexcept : code_(code) {}
 
+        [[nodiscard]] constexpr bool retriable() const noexcept { return code_ == Busy; }
+
         [[nodiscard]] constexpr unsigned long code() const noexcept {
             return code_;
         }
@@ -26,6 +31,9 @@ namespace mehara::prapancha::security {
             if (code_ == 0) {
                 return std::nullopt;
             }
+            if (code_ == Busy) {
+                return "Service saturated; retry later.";
+            }
             const std::unique_ptr<BIO, decltype(&BIO_free)> bio(BIO_new(BIO_s_mem()), BIO_free);
             if (!bio) {
                 return std::nullopt;
@@ -5,6 +5,7 @@
 #ifndef PRAPANCHA_SECURITY_HASHER_H_
 #define PRAPANCHA_SECURITY_HASHER_H_
 
+#include <chrono>
 #include <cstdint>
 #include <expected>
 #include <istream>
@@ -22,6 +23,33 @@ namespace mehara::prapancha::security {
         bool operator==(const Argon2idBinding &) const = default;
     };
 
+    /// Cost parameters new Argon2id bindings are created with. Bindings record their own, so changing these never
+    /// affects verification of bindings already stored.
+    struct Argon2idParameters {
+        std::uint32_t m; ///< Memory in KiB.
+        std::uint32_t t; ///< Passes over the memory.
+        std::uint32_t p; ///< Lanes.
+        bool operator==(const Argon2idParameters &) const = default;
+    };
+
+    /// What startup calibration aims for: the strongest parameters whose hash takes at most `latency` on this host
+    /// and fills at most `max_memory` KiB. Memory is favoured over passes, as RFC 9106 recommends.
+    struct Argon2idTarget {
+        static constexpr std::uint32_t DefaultMinMemory = 19 * 1024; ///< OWASP's floor for Argon2id, in KiB.
+
+        std::chrono::milliseconds latency;
+        std::uint32_t max_memory;
+        std::uint32_t min_memory = DefaultMinMemory;
+        std::uint32_t lanes = 4;
+    };
+
+    struct Argon2idCalibration {
+        Argon2idParameters parameters;
+        std::chrono::nanoseconds latency; ///< Measured cost of one hash with `parameters`.
+        std::uint32_t trials; ///< Derivations run to find them.
+        bool met; ///< False if even the cheapest allowed parameters exceeded the target.
+    };
+
     struct Sha256Binding {
         std::vector<uint8_t> hash;
         bool operator==(const Sha256Binding &) const = default;
@@ -30,6 +58,9 @@ namespace mehara::prapancha::security {
     struct Argon2id {
         using Binding = Argon2idBinding;
         static constexpr std::string_view name = "ARGON2ID";
+        static constexpr std::uint32_t memory_cost = 65536; ///< Default KiB of memory each derivation fills.
+        static constexpr std::uint32_t time_cost = 3; ///< Default passes over that memory.
+        static constexpr std::uint32_t lanes = 4;
     };
 
     struct Sha256 {
@@ -57,6 +88,25 @@ namespace mehara::prapancha::security {
             return verify(data, binding, Algorithm{});
         }
 
+        /// Lets each Argon2id derivation fill its lanes from up to `threads_per_hash` threads of OpenSSL's internal
+        /// pool, which is capped at `max_threads` for the whole process. Derivations running at once share that cap
+        /// and fall back to fewer threads rather than oversubscribing cores. A `threads_per_hash` of one, the
+        /// default, fills every lane on the calling thread and leaves the pool unused.
+        static std::expected<void, Error> set_argon2id_threads(std::uint32_t threads_per_hash,
+                                                               std::uint64_t max_threads);
+
+        [[nodiscard]] static std::uint32_t argon2id_threads_per_hash() noexcept;
+
+        /// Parameters new Argon2id bindings are created with; Argon2id's defaults until set otherwise.
+        [[nodiscard]] static Argon2idParameters argon2id_parameters() noexcept;
+
+        /// Replaces the parameters for new bindings. Meant for startup, before hashing begins.
+        static void set_argon2id_parameters(const Argon2idParameters &parameters) noexcept;
+
+        /// Benchmarks Argon2id derivations on this host, with the thread settings already in effect, and returns the
+        /// strongest parameters that meet the target. It does not apply them.
+        static std::expected<Argon2idCalibration, Error> calibrate_argon2id(const Argon2idTarget &target);
+
     private:
         static std::expected<Argon2idBinding, Error> hash(std::string_view, Argon2id);
         static std::expected<bool, Error> verify(std::string_view, const Argon2idBinding &, Argon2id);
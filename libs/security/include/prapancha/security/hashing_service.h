@@ -0,0 +1,110 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SECURITY_HASHING_SERVICE_H_
+#define PRAPANCHA_SECURITY_HASHING_SERVICE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <prapancha/security/error.h>
+#include <prapancha/security/hasher.h>
+
+namespace mehara::prapancha::security {
+
+    /// HashingService Class
+    ///
+    /// Runs Argon2id derivations on a fixed pool of worker threads. Every derivation holds its memory cost against a
+    /// shared budget for as long as it runs, so the memory Argon2id can claim is bounded however many requests
+    /// arrive. Work waits in a bounded queue; once the queue is full, further work is refused at once with
+    /// Error::Busy instead of growing the backlog.
+    ///
+    /// Completions run on a worker thread.
+    class HashingService final {
+    public:
+        struct Options {
+            static constexpr std::size_t DefaultQueueCapacity = 64;
+            static constexpr std::uint64_t DefaultMemoryBudget = 1ULL << 30; ///< Bytes; 16 default derivations.
+
+            std::size_t workers = 0; ///< Zero uses one per hardware thread.
+            std::size_t queue_capacity = DefaultQueueCapacity;
+            std::uint64_t memory_budget = DefaultMemoryBudget;
+        };
+
+        /// Running totals. Wait time runs from submission until a worker starts the derivation.
+        struct Metrics {
+            std::atomic<std::uint64_t> submitted{0};
+            std::atomic<std::uint64_t> rejected{0};
+            std::atomic<std::uint64_t> completed{0};
+            std::atomic<std::uint64_t> queue_depth{0};
+            std::atomic<std::uint64_t> peak_queue_depth{0};
+            std::atomic<std::uint64_t> wait_nanoseconds{0};
+            std::atomic<std::uint64_t> peak_wait_nanoseconds{0};
+        };
+
+        using HashCompletion = std::move_only_function<void(std::expected<Argon2idBinding, Error>)>;
+        using VerifyCompletion = std::move_only_function<void(std::expected<bool, Error>)>;
+
+    private:
+        struct Job {
+            std::uint64_t memory; ///< Bytes held against the budget while the job runs.
+            std::chrono::steady_clock::time_point submitted;
+            std::move_only_function<void()> run;
+        };
+
+        std::size_t capacity_;
+        std::uint64_t budget_;
+        std::uint64_t available_;
+        std::mutex mutex_;
+        std::condition_variable ready_;
+        std::deque<Job> queue_;
+        bool stopping_ = false;
+        Metrics metrics_;
+        std::vector<std::jthread> workers_;
+
+        [[nodiscard]] bool enqueue(std::uint64_t memory, std::move_only_function<void()> &&run);
+
+        void work();
+
+    public:
+        explicit HashingService(Options options);
+
+        HashingService(const HashingService &) = delete;
+        HashingService &operator=(const HashingService &) = delete;
+
+        /// Finishes the work already queued, then joins the workers.
+        ~HashingService();
+
+        /// Bytes a derivation with memory cost `m` (in KiB) holds against the budget.
+        [[nodiscard]] static constexpr std::uint64_t memory_of(const std::uint32_t m) noexcept {
+            return static_cast<std::uint64_t>(m) * 1024;
+        }
+
+        /// Queues a hash of `password`. A refusal completes inline with Error::Busy.
+        void hash(std::string password, HashCompletion &&completion);
+
+        /// Queues a verification of `password` against `binding`, charged at the binding's own memory cost.
+        void verify(std::string password, Argon2idBinding binding, VerifyCompletion &&completion);
+
+        [[nodiscard]] std::future<std::expected<Argon2idBinding, Error>> hash(std::string password);
+
+        [[nodiscard]] std::future<std::expected<bool, Error>> verify(std::string password, Argon2idBinding binding);
+
+        [[nodiscard]] const Metrics &metrics() const noexcept { return metrics_; }
+    };
+
+} // namespace mehara::prapancha::security
+
+#endif // PRAPANCHA_SECURITY_HASHING_SERVICE_H_
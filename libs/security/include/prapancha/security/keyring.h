@@ -0,0 +1,100 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#ifndef PRAPANCHA_SECURITY_KEYRING_H_
+#define PRAPANCHA_SECURITY_KEYRING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <openssl/evp.h>
+
+#include <prapancha/security/error.h>
+#include <prapancha/security/signer.h>
+
+namespace mehara::prapancha::security {
+
+    /// One signature to check against a keyring key.
+    struct Ed25519Check {
+        std::string_view key_id;
+        std::span<const uint8_t> data;
+        std::span<const uint8_t> signature;
+    };
+
+    /// Ed25519Keyring Class
+    ///
+    /// Ed25519 public keys, parsed once and looked up by key id. Readers work from an immutable snapshot published
+    /// through an atomic shared_ptr, so a verification never waits on a rotation; writers copy the snapshot, change
+    /// the copy and publish it, one at a time. A check that started before a rotation finishes against the keys it
+    /// began with.
+    class Ed25519Keyring final {
+    public:
+        /// Batches at least this long are split across threads by verify_many().
+        static constexpr std::size_t DefaultParallelThreshold = 256;
+
+    private:
+        struct Hash {
+            using is_transparent = void;
+            std::size_t operator()(const std::string_view id) const noexcept {
+                return std::hash<std::string_view>{}(id);
+            }
+        };
+
+        using Key = Ed25519Key;
+        using Keys = std::unordered_map<std::string, Key, Hash, std::equal_to<>>;
+
+        std::atomic<std::shared_ptr<const Keys>> keys_;
+        std::mutex rotation_;
+
+        [[nodiscard]] std::shared_ptr<const Keys> snapshot() const noexcept {
+            return keys_.load(std::memory_order_acquire);
+        }
+
+        static std::expected<void, Error> verify(const Keys &keys, std::span<const Ed25519Check> checks,
+                                                 std::span<bool> results);
+
+    public:
+        Ed25519Keyring();
+
+        Ed25519Keyring(const Ed25519Keyring &) = delete;
+        Ed25519Keyring &operator=(const Ed25519Keyring &) = delete;
+
+        /// Parses a raw 32-byte public key and publishes it under `id`, replacing any key already there.
+        std::expected<void, Error> add(std::string id, std::span<const uint8_t> public_key);
+
+        /// Retires the key under `id`. Returns false if there was none.
+        bool remove(std::string_view id);
+
+        [[nodiscard]] bool contains(std::string_view id) const;
+
+        [[nodiscard]] std::size_t size() const;
+
+        /// Checks one signature. A key id the keyring does not hold fails verification rather than erroring.
+        [[nodiscard]] std::expected<bool, Error> verify(std::string_view id, std::span<const uint8_t> data,
+                                                        std::span<const uint8_t> signature) const;
+
+        /// Checks every entry of `checks` into the matching entry of `results`, which must be as long. All checks
+        /// see the same snapshot and reuse each thread's digest context. Batches of at least `parallel_threshold`
+        /// are split across up to one thread per core; see threads_for(). An error means OpenSSL itself failed, not
+        /// a bad signature.
+        std::expected<void, Error> verify_many(std::span<const Ed25519Check> checks, std::span<bool> results,
+                                               std::size_t parallel_threshold = DefaultParallelThreshold) const;
+
+        /// Threads verify_many() splits a batch of `checks` across: one below `parallel_threshold`, otherwise one per
+        /// core but never more than there are checks.
+        [[nodiscard]] static std::size_t threads_for(std::size_t checks, std::size_t parallel_threshold) noexcept;
+    };
+
+} // namespace mehara::prapancha::security
+
+#endif // PRAPANCHA_SECURITY_KEYRING_H_
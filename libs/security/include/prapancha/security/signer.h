@@ -5,18 +5,43 @@
 #ifndef PRAPANCHA_SECURITY_SIGNER_H_
 #define PRAPANCHA_SECURITY_SIGNER_H_
 
+#include <cstdint>
 #include <expected>
-#include <prapancha/security/error.h>
+#include <memory>
+#include <span>
 #include <vector>
 
+#include <openssl/evp.h>
+
+#include <prapancha/security/error.h>
+
 namespace mehara::prapancha::security {
 
     struct Ed25519Binding {
         std::vector<uint8_t> signature;
         bool operator==(const Ed25519Binding &) const = default;
     };
+
+    /// Ed25519 key parsed once. Signing or verifying through it skips OpenSSL's per-call key setup; copies share the
+    /// parsed key.
+    class Ed25519Key {
+        std::shared_ptr<EVP_PKEY> key_;
+
+        explicit Ed25519Key(std::shared_ptr<EVP_PKEY> key) noexcept : key_(std::move(key)) {}
+
+    public:
+        /// Parses a raw 32-byte private key.
+        static std::expected<Ed25519Key, Error> from_private(std::span<const uint8_t> raw);
+
+        /// Parses a raw 32-byte public key.
+        static std::expected<Ed25519Key, Error> from_public(std::span<const uint8_t> raw);
+
+        [[nodiscard]] EVP_PKEY *get() const noexcept { return key_.get(); }
+    };
+
     struct Ed25519 {
         using Binding = Ed25519Binding;
+        using Key = Ed25519Key;
     };
 
     class Signer {
@@ -36,11 +61,28 @@ namespace mehara::prapancha::security {
             return verify(data, binding, public_key, Algorithm{});
         }
 
+        /// Signs with a key parsed once up front; prefer this over raw key bytes on any repeated path.
+        template<typename Algorithm>
+        static std::expected<typename Algorithm::Binding, Error> sign(const std::vector<uint8_t> &data,
+                                                                      const typename Algorithm::Key &private_key) {
+            return sign(data, private_key, Algorithm{});
+        }
+
+        template<typename Algorithm>
+        static std::expected<bool, Error> verify(const std::vector<uint8_t> &data,
+                                                 const typename Algorithm::Binding &binding,
+                                                 const typename Algorithm::Key &public_key) {
+            return verify(data, binding, public_key, Algorithm{});
+        }
+
     private:
         static std::expected<Ed25519Binding, Error> sign(const std::vector<uint8_t> &, const std::vector<uint8_t> &,
                                                          Ed25519);
         static std::expected<bool, Error> verify(const std::vector<uint8_t> &, const Ed25519Binding &,
                                                  const std::vector<uint8_t> &, Ed25519);
+        static std::expected<Ed25519Binding, Error> sign(const std::vector<uint8_t> &, const Ed25519Key &, Ed25519);
+        static std::expected<bool, Error> verify(const std::vector<uint8_t> &, const Ed25519Binding &,
+                                                 const Ed25519Key &, Ed25519);
     };
 
 } // namespace mehara::prapancha::security
@@ -0,0 +1,65 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <prapancha/security/algorithms.h>
+
+#include <memory>
+
+#include <prapancha/security/hasher.h>
+
+namespace mehara::prapancha::security::algorithms {
+
+    EVP_KDF *argon2id() noexcept {
+        static const auto kdf = std::unique_ptr<EVP_KDF, decltype(&EVP_KDF_free)>(
+                EVP_KDF_fetch(nullptr, Argon2id::name.data(), nullptr), EVP_KDF_free);
+        return kdf.get();
+    }
+
+    EVP_MD *sha256() noexcept {
+        static const auto md = std::unique_ptr<EVP_MD, decltype(&EVP_MD_free)>(
+                EVP_MD_fetch(nullptr, Sha256::name.data(), nullptr), EVP_MD_free);
+        return md.get();
+    }
+
+    EVP_CIPHER *aes_256_gcm() noexcept {
+        static const auto cipher = std::unique_ptr<EVP_CIPHER, decltype(&EVP_CIPHER_free)>(
+                EVP_CIPHER_fetch(nullptr, "AES-256-GCM", nullptr), EVP_CIPHER_free);
+        return cipher.get();
+    }
+
+    EVP_KDF_CTX *kdf_context() noexcept {
+        // A KDF context is bound to the algorithm it was made for; Argon2id is the only KDF in use.
+        thread_local const auto ctx = std::unique_ptr<EVP_KDF_CTX, decltype(&EVP_KDF_CTX_free)>(
+                argon2id() ? EVP_KDF_CTX_new(argon2id()) : nullptr, EVP_KDF_CTX_free);
+        if (ctx) {
+            EVP_KDF_CTX_reset(ctx.get());
+        }
+        return ctx.get();
+    }
+
+    EVP_MD_CTX *digest_context() noexcept {
+        thread_local const auto ctx =
+                std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+        if (ctx) {
+            EVP_MD_CTX_reset(ctx.get());
+        }
+        return ctx.get();
+    }
+
+    EVP_CIPHER_CTX *cipher_context() noexcept {
+        // Bound to AES-256-GCM once and never reset: a reset frees the provider's cipher state, which a re-init with
+        // a null cipher keeps.
+        thread_local const auto ctx = [] {
+            auto made = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>(EVP_CIPHER_CTX_new(),
+                                                                                         EVP_CIPHER_CTX_free);
+            if (made && (!aes_256_gcm() ||
+                         EVP_CipherInit_ex2(made.get(), aes_256_gcm(), nullptr, nullptr, -1, nullptr) <= 0)) {
+                made.reset();
+            }
+            return made;
+        }();
+        return ctx.get();
+    }
+
+} // namespace mehara::prapancha::security::algorithms
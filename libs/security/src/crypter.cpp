@@ -4,71 +4,257 @@
 
 #include <prapancha/security/crypter.h>
 
-#include <memory>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
 #include <vector>
 
 #include <openssl/err.h>
 #include <openssl/evp.h>
 #include <openssl/rand.h>
 
+#include <prapancha/security/algorithms.h>
 #include <prapancha/security/error.h>
 
 namespace mehara::prapancha::security {
 
-    std::expected<Aes256GcmBinding, Error> Crypter::encrypt(const std::vector<uint8_t> &plain,
-                                                            const std::vector<uint8_t> &key, Aes256Gcm) {
+    namespace {
+
+        /// Records a rejected argument the way OpenSSL records its own failures.
+        Error invalid(const int reason) {
+            ERR_raise(ERR_LIB_EVP, reason);
+            return Error(ERR_get_error());
+        }
+
+        /// Feeds associated data, which produces no output.
+        std::expected<void, Error> authenticate(EVP_CIPHER_CTX *ctx, const std::span<const uint8_t> aad,
+                                                const bool encrypting) {
+            if (aad.empty()) {
+                return {};
+            }
+            if (aad.size() > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+                return std::unexpected(invalid(EVP_R_INVALID_LENGTH));
+            }
+            int length = 0;
+            const int size = static_cast<int>(aad.size());
+            const int result = encrypting ? EVP_EncryptUpdate(ctx, nullptr, &length, aad.data(), size)
+                                          : EVP_DecryptUpdate(ctx, nullptr, &length, aad.data(), size);
+            if (result <= 0) {
+                return std::unexpected(Error(ERR_get_error()));
+            }
+            return {};
+        }
+
+        /// Runs `in` through the cipher into `out` in chunks OpenSSL's int lengths can express. GCM produces exactly
+        /// one output byte per input byte, so chunk boundaries do not matter.
+        std::expected<void, Error> transform(EVP_CIPHER_CTX *ctx, std::span<const uint8_t> in, std::span<uint8_t> out,
+                                             const bool encrypting) {
+            if (out.size() < in.size()) {
+                return std::unexpected(invalid(EVP_R_BUFFER_TOO_SMALL));
+            }
+            constexpr std::size_t chunk = std::numeric_limits<int>::max() & ~std::size_t{15};
+            while (!in.empty()) {
+                const std::size_t size = std::min(in.size(), chunk);
+                int length = 0;
+                const int result = encrypting ? EVP_EncryptUpdate(ctx, out.data(), &length, in.data(),
+                                                                  static_cast<int>(size))
+                                              : EVP_DecryptUpdate(ctx, out.data(), &length, in.data(),
+                                                                  static_cast<int>(size));
+                if (result <= 0) {
+                    return std::unexpected(Error(ERR_get_error()));
+                }
+                in = in.subspan(size);
+                out = out.subspan(static_cast<std::size_t>(length));
+            }
+            return {};
+        }
+
+        std::expected<void, Error> seal(EVP_CIPHER_CTX *ctx, Aes256GcmSeal &seal) {
+            int length = 0;
+            if (EVP_EncryptFinal_ex(ctx, nullptr, &length) <= 0 ||
+                EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, static_cast<int>(Aes256Gcm::tag_length),
+                                    seal.tag.data()) <= 0) {
+                return std::unexpected(Error(ERR_get_error()));
+            }
+            return {};
+        }
+
+        std::expected<void, Error> open(EVP_CIPHER_CTX *ctx, const std::span<const uint8_t> tag) {
+            if (tag.size() != Aes256Gcm::tag_length) {
+                return std::unexpected(invalid(EVP_R_INVALID_LENGTH));
+            }
+            int length = 0;
+            if (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, static_cast<int>(tag.size()),
+                                    const_cast<uint8_t *>(tag.data())) <= 0 ||
+                EVP_DecryptFinal_ex(ctx, nullptr, &length) <= 0) {
+                return std::unexpected(Error(ERR_get_error()));
+            }
+            return {};
+        }
+
+        /// Keys `ctx` for one message. A null `cipher` re-keys a context already bound to AES-256-GCM and keeps its
+        /// provider state; naming the cipher builds that state afresh.
+        std::expected<void, Error> start(EVP_CIPHER_CTX *ctx, const EVP_CIPHER *cipher,
+                                         const std::span<const uint8_t> key, const std::span<const uint8_t> iv,
+                                         const bool encrypting) {
+            if (!ctx) {
+                return std::unexpected(Error(ERR_get_error()));
+            }
+            if (key.size() != Aes256Gcm::key_length) {
+                return std::unexpected(invalid(EVP_R_INVALID_KEY_LENGTH));
+            }
+            if (iv.size() != Aes256Gcm::iv_length) {
+                return std::unexpected(invalid(EVP_R_INVALID_IV_LENGTH));
+            }
+            const int result = encrypting ? EVP_EncryptInit_ex2(ctx, cipher, key.data(), iv.data(), nullptr)
+                                          : EVP_DecryptInit_ex2(ctx, cipher, key.data(), iv.data(), nullptr);
+            if (result <= 0) {
+                return std::unexpected(Error(ERR_get_error()));
+            }
+            return {};
+        }
+
+        std::expected<void, Error> randomize(std::span<uint8_t> iv) {
+            if (RAND_bytes(iv.data(), static_cast<int>(iv.size())) != 1) {
+                return std::unexpected(Error(ERR_get_error()));
+            }
+            return {};
+        }
+
+    } // namespace
+
+    Aes256GcmEncryptor::Aes256GcmEncryptor() noexcept : ctx_(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free) {}
+
+    std::expected<Aes256GcmEncryptor, Error> Aes256GcmEncryptor::create(const std::span<const uint8_t> key) {
         ERR_clear_error();
-        const auto ctx = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>(EVP_CIPHER_CTX_new(),
-                                                                                         EVP_CIPHER_CTX_free);
-        if (!ctx) {
-            return std::unexpected(Error(ERR_get_error()));
+        Aes256GcmEncryptor encryptor;
+        if (auto result = randomize(encryptor.seal_.iv); !result) {
+            return std::unexpected(result.error());
         }
-        std::vector<uint8_t> iv(12);
-        if (RAND_bytes(iv.data(), static_cast<int>(iv.size())) != 1) {
-            return std::unexpected(Error(ERR_get_error()));
+        if (auto result = start(encryptor.ctx_.get(), algorithms::aes_256_gcm(), key, encryptor.seal_.iv, true); !result) {
+            return std::unexpected(result.error());
         }
-        if (EVP_EncryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr, key.data(), iv.data()) <= 0) {
-            return std::unexpected(Error(ERR_get_error()));
+        return encryptor;
+    }
+
+    std::expected<void, Error> Aes256GcmEncryptor::authenticate(const std::span<const uint8_t> aad) {
+        ERR_clear_error();
+        return security::authenticate(ctx_.get(), aad, true);
+    }
+
+    std::expected<void, Error> Aes256GcmEncryptor::update(const std::span<const uint8_t> plain,
+                                                          const std::span<uint8_t> cipher) {
+        ERR_clear_error();
+        return transform(ctx_.get(), plain, cipher, true);
+    }
+
+    std::expected<Aes256GcmSeal, Error> Aes256GcmEncryptor::finish() {
+        ERR_clear_error();
+        if (auto result = seal(ctx_.get(), seal_); !result) {
+            return std::unexpected(result.error());
         }
-        std::vector<uint8_t> cipher(plain.size());
-        int length = 0;
-        if (EVP_EncryptUpdate(ctx.get(), cipher.data(), &length, plain.data(), static_cast<int>(plain.size())) <= 0) {
-            return std::unexpected(Error(ERR_get_error()));
+        return seal_;
+    }
+
+    Aes256GcmDecryptor::Aes256GcmDecryptor() noexcept : ctx_(EVP_CIPHER_CTX_new(), EVP_CIPHER_CTX_free) {}
+
+    std::expected<Aes256GcmDecryptor, Error> Aes256GcmDecryptor::create(const std::span<const uint8_t> key,
+                                                                        const std::span<const uint8_t> iv) {
+        ERR_clear_error();
+        Aes256GcmDecryptor decryptor;
+        if (auto result = start(decryptor.ctx_.get(), algorithms::aes_256_gcm(), key, iv, false); !result) {
+            return std::unexpected(result.error());
+        }
+        return decryptor;
+    }
+
+    std::expected<void, Error> Aes256GcmDecryptor::authenticate(const std::span<const uint8_t> aad) {
+        ERR_clear_error();
+        return security::authenticate(ctx_.get(), aad, false);
+    }
+
+    std::expected<void, Error> Aes256GcmDecryptor::update(const std::span<const uint8_t> cipher,
+                                                          const std::span<uint8_t> plain) {
+        ERR_clear_error();
+        return transform(ctx_.get(), cipher, plain, false);
+    }
+
+    std::expected<void, Error> Aes256GcmDecryptor::finish(const std::span<const uint8_t> tag) {
+        ERR_clear_error();
+        return open(ctx_.get(), tag);
+    }
+
+    std::expected<Aes256GcmSeal, Error> Crypter::encrypt(const std::span<const uint8_t> plain,
+                                                         const std::span<uint8_t> cipher,
+                                                         const std::span<const uint8_t> key,
+                                                         const std::span<const uint8_t> aad, Aes256Gcm) {
+        ERR_clear_error();
+        EVP_CIPHER_CTX *const ctx = algorithms::cipher_context();
+        Aes256GcmSeal sealed{};
+        if (auto result = randomize(sealed.iv); !result) {
+            return std::unexpected(result.error());
         }
-        int final_length = 0;
-        if (EVP_EncryptFinal_ex(ctx.get(), cipher.data() + length, &final_length) <= 0) {
-            return std::unexpected(Error(ERR_get_error()));
+        if (auto result = start(ctx, nullptr, key, sealed.iv, true); !result) {
+            return std::unexpected(result.error());
         }
-        std::vector<uint8_t> tag(16);
-        if (EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_GET_TAG, 16, tag.data()) <= 0) {
-            return std::unexpected(Error(ERR_get_error()));
+        if (auto result = authenticate(ctx, aad, true); !result) {
+            return std::unexpected(result.error());
         }
-        return Aes256GcmBinding{std::move(iv), std::move(tag), std::move(cipher)};
+        if (auto result = transform(ctx, plain, cipher, true); !result) {
+            return std::unexpected(result.error());
+        }
+        if (auto result = seal(ctx, sealed); !result) {
+            return std::unexpected(result.error());
+        }
+        return sealed;
     }
 
-    std::expected<std::vector<uint8_t>, Error> Crypter::decrypt(const Aes256GcmBinding &binding,
-                                                                const std::vector<uint8_t> &key, Aes256Gcm) {
+    std::expected<void, Error> Crypter::decrypt(const Aes256GcmSeal &seal, const std::span<const uint8_t> cipher,
+                                                const std::span<uint8_t> plain, const std::span<const uint8_t> key,
+                                                const std::span<const uint8_t> aad, Aes256Gcm) {
         ERR_clear_error();
-        const auto ctx = std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>(EVP_CIPHER_CTX_new(),
-                                                                                         EVP_CIPHER_CTX_free);
-        if (!ctx) {
-            return std::unexpected(Error(ERR_get_error()));
+        EVP_CIPHER_CTX *const ctx = algorithms::cipher_context();
+        if (auto result = start(ctx, nullptr, key, seal.iv, false); !result) {
+            return result;
         }
-        if (EVP_DecryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr, key.data(), binding.iv.data()) <= 0) {
-            return std::unexpected(Error(ERR_get_error()));
+        if (auto result = authenticate(ctx, aad, false); !result) {
+            return result;
         }
-        std::vector<uint8_t> plain(binding.ciphertext.size());
-        int length = 0;
-        if (EVP_DecryptUpdate(ctx.get(), plain.data(), &length, binding.ciphertext.data(),
-                              static_cast<int>(binding.ciphertext.size())) <= 0) {
-            return std::unexpected(Error(ERR_get_error()));
+        if (auto result = transform(ctx, cipher, plain, false); !result) {
+            return result;
+        }
+        return open(ctx, seal.tag);
+    }
+
+    std::expected<Aes256GcmBinding, Error> Crypter::encrypt(const std::vector<uint8_t> &plain,
+                                                            const std::vector<uint8_t> &key,
+                                                            const std::span<const uint8_t> aad, Aes256Gcm) {
+        std::vector<uint8_t> cipher(plain.size());
+        const auto sealed = encrypt(plain, cipher, key, aad, Aes256Gcm{});
+        if (!sealed) {
+            return std::unexpected(sealed.error());
         }
-        if (EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_AEAD_SET_TAG, 16, const_cast<uint8_t *>(binding.tag.data())) <= 0) {
-            return std::unexpected(Error(ERR_get_error()));
+        return Aes256GcmBinding{{sealed->iv.begin(), sealed->iv.end()}, {sealed->tag.begin(), sealed->tag.end()},
+                                std::move(cipher)};
+    }
+
+    std::expected<std::vector<uint8_t>, Error> Crypter::decrypt(const Aes256GcmBinding &binding,
+                                                                const std::vector<uint8_t> &key,
+                                                                const std::span<const uint8_t> aad, Aes256Gcm) {
+        if (binding.iv.size() != Aes256Gcm::iv_length) {
+            ERR_clear_error();
+            return std::unexpected(invalid(EVP_R_INVALID_IV_LENGTH));
+        }
+        if (binding.tag.size() != Aes256Gcm::tag_length) {
+            ERR_clear_error();
+            return std::unexpected(invalid(EVP_R_INVALID_LENGTH));
         }
-        int final_length = 0;
-        if (EVP_DecryptFinal_ex(ctx.get(), plain.data() + length, &final_length) <= 0) {
-            return std::unexpected(Error(ERR_get_error()));
+        Aes256GcmSeal seal{};
+        std::ranges::copy(binding.iv, seal.iv.begin());
+        std::ranges::copy(binding.tag, seal.tag.begin());
+        std::vector<uint8_t> plain(binding.ciphertext.size());
+        if (auto result = decrypt(seal, binding.ciphertext, plain, key, aad, Aes256Gcm{}); !result) {
+            return std::unexpected(result.error());
         }
         return plain;
     }
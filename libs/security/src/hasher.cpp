@@ -3,7 +3,10 @@
 //
 #include <prapancha/security/hasher.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <expected>
@@ -18,28 +21,72 @@
 #include <openssl/kdf.h>
 #include <openssl/params.h>
 #include <openssl/rand.h>
+#include <openssl/thread.h>
+
+#include <prapancha/security/algorithms.h>
 
 namespace mehara::prapancha::security {
 
     namespace {
 
         constexpr std::uint32_t argon2id_version = 0x13;
-        constexpr std::uint32_t argon2id_m = 65536;
-        constexpr std::uint32_t argon2id_t = 3;
-        constexpr std::uint32_t argon2id_p = 4;
+        std::atomic<std::uint32_t> argon2id_m{Argon2id::memory_cost};
+        std::atomic<std::uint32_t> argon2id_t{Argon2id::time_cost};
+        std::atomic<std::uint32_t> argon2id_p{Argon2id::lanes};
         constexpr std::size_t argon2id_salt_length = 16;
         constexpr std::size_t argon2id_hash_length = 32;
+        constexpr std::string_view calibration_password = "prapancha-calibration";
+
+        /// Threads one derivation asks OpenSSL's pool for, and the pool threads not claimed by running derivations.
+        std::atomic<std::uint32_t> argon2id_threads{1};
+        std::atomic<std::uint64_t> argon2id_free_threads{0};
+
+        /// Pool threads held by one derivation. OpenSSL fails a derivation that asks for more threads than the pool
+        /// has free, so each derivation claims its threads here first and takes fewer, down to none, when concurrent
+        /// derivations hold the rest. The thread count only changes how fast the lanes are filled, never the hash.
+        class ThreadReservation {
+            std::uint32_t held_ = 0;
+
+        public:
+            explicit ThreadReservation(const std::uint32_t lanes) noexcept {
+                const std::uint32_t wanted = std::min(argon2id_threads.load(std::memory_order_relaxed), lanes);
+                if (wanted <= 1) {
+                    return;
+                }
+                std::uint64_t free = argon2id_free_threads.load(std::memory_order_relaxed);
+                std::uint64_t take = 0;
+                do {
+                    take = std::min<std::uint64_t>(free, wanted);
+                } while (take > 1 && !argon2id_free_threads.compare_exchange_weak(free, free - take,
+                                                                                 std::memory_order_acquire,
+                                                                                 std::memory_order_relaxed));
+                held_ = take > 1 ? static_cast<std::uint32_t>(take) : 0;
+            }
+
+            ThreadReservation(const ThreadReservation &) = delete;
+            ThreadReservation &operator=(const ThreadReservation &) = delete;
+
+            ~ThreadReservation() {
+                if (held_ != 0) {
+                    argon2id_free_threads.fetch_add(held_, std::memory_order_release);
+                }
+            }
+
+            /// Threads to request; one means the calling thread fills every lane itself.
+            [[nodiscard]] std::uint32_t threads() const noexcept { return std::max<std::uint32_t>(held_, 1); }
+        };
 
         auto construct_algorithm_params(std::string_view password, const std::uint32_t *version, const std::uint32_t *m,
-                                        const std::uint32_t *t, const std::uint32_t *p,
+                                        const std::uint32_t *t, const std::uint32_t *p, const std::uint32_t *threads,
                                         const std::vector<uint8_t> &salt, Argon2id) noexcept
-                -> std::array<OSSL_PARAM, 7> {
+                -> std::array<OSSL_PARAM, 8> {
             return {OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_PASSWORD, const_cast<char *>(password.data()),
                                                       password.size()),
                     OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_ARGON2_VERSION, const_cast<uint32_t *>(version)),
                     OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_ARGON2_MEMCOST, const_cast<uint32_t *>(m)),
                     OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_ITER, const_cast<uint32_t *>(t)),
                     OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_ARGON2_LANES, const_cast<uint32_t *>(p)),
+                    OSSL_PARAM_construct_uint32(OSSL_KDF_PARAM_THREADS, const_cast<uint32_t *>(threads)),
                     OSSL_PARAM_construct_octet_string(OSSL_KDF_PARAM_SALT, const_cast<uint8_t *>(salt.data()),
                                                       salt.size()),
                     OSSL_PARAM_construct_end()};
@@ -47,15 +94,92 @@ namespace mehara::prapancha::security {
 
     } // namespace
 
-    std::expected<Argon2idBinding, Error> Hasher::hash(const std::string_view data, const Argon2id algorithm) {
+    std::expected<void, Error> Hasher::set_argon2id_threads(const std::uint32_t threads_per_hash,
+                                                            const std::uint64_t max_threads) {
         ERR_clear_error();
-        const auto kdf = std::unique_ptr<EVP_KDF, decltype(&EVP_KDF_free)>(
-                EVP_KDF_fetch(nullptr, Argon2id::name.data(), nullptr), EVP_KDF_free);
-        if (!kdf) {
+        const std::uint64_t pool = threads_per_hash > 1 ? max_threads : 0;
+        if (OSSL_set_max_threads(nullptr, pool) != 1) {
             return std::unexpected(Error(ERR_get_error()));
         }
-        const auto ctx =
-                std::unique_ptr<EVP_KDF_CTX, decltype(&EVP_KDF_CTX_free)>(EVP_KDF_CTX_new(kdf.get()), EVP_KDF_CTX_free);
+        argon2id_threads.store(std::max<std::uint32_t>(threads_per_hash, 1), std::memory_order_relaxed);
+        argon2id_free_threads.store(pool, std::memory_order_relaxed);
+        return {};
+    }
+
+    std::uint32_t Hasher::argon2id_threads_per_hash() noexcept {
+        return argon2id_threads.load(std::memory_order_relaxed);
+    }
+
+    Argon2idParameters Hasher::argon2id_parameters() noexcept {
+        return {argon2id_m.load(std::memory_order_relaxed), argon2id_t.load(std::memory_order_relaxed),
+                argon2id_p.load(std::memory_order_relaxed)};
+    }
+
+    void Hasher::set_argon2id_parameters(const Argon2idParameters &parameters) noexcept {
+        argon2id_m.store(parameters.m, std::memory_order_relaxed);
+        argon2id_t.store(parameters.t, std::memory_order_relaxed);
+        argon2id_p.store(parameters.p, std::memory_order_relaxed);
+    }
+
+    std::expected<Argon2idCalibration, Error> Hasher::calibrate_argon2id(const Argon2idTarget &target) {
+        using std::chrono::steady_clock;
+        const std::uint32_t lanes = std::max<std::uint32_t>(target.lanes, 1);
+        // Argon2 needs at least 8 KiB per lane; memory is kept a whole number of blocks per lane.
+        const auto align = [lanes](const std::uint32_t m) { return std::max(m / (8 * lanes), 1U) * 8 * lanes; };
+        const std::uint32_t floor = align(std::min(target.min_memory, target.max_memory));
+        std::uint32_t trials = 0;
+        // The faster of two runs, so a single scheduling hiccup does not halve the memory chosen.
+        const auto measure = [&](const Argon2idParameters &parameters) -> std::expected<steady_clock::duration, Error> {
+            const Argon2idBinding probe{argon2id_version, parameters.m, parameters.t, parameters.p,
+                                        std::vector<uint8_t>(argon2id_salt_length),
+                                        std::vector<uint8_t>(argon2id_hash_length)};
+            auto fastest = steady_clock::duration::max();
+            for (int run = 0; run < 2; ++run) {
+                const auto start = steady_clock::now();
+                if (const auto result = verify(calibration_password, probe, Argon2id{}); !result) {
+                    return std::unexpected(result.error());
+                }
+                fastest = std::min(fastest, steady_clock::now() - start);
+                ++trials;
+            }
+            return fastest;
+        };
+        // Largest memory that fits the target in a single pass, halving from the ceiling.
+        Argon2idParameters parameters{align(target.max_memory), 1, lanes};
+        auto latency = measure(parameters);
+        while (latency && *latency > target.latency && parameters.m > floor) {
+            parameters.m = std::max(align(parameters.m / 2), floor);
+            latency = measure(parameters);
+        }
+        if (!latency) {
+            return std::unexpected(latency.error());
+        }
+        if (*latency > target.latency) {
+            return Argon2idCalibration{parameters, *latency, trials, false};
+        }
+        // Time grows linearly with passes, so the single-pass cost predicts how many fit; back off if it overshoots.
+        const auto single = *latency;
+        parameters.t = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(target.latency / single));
+        while (parameters.t > 1) {
+            latency = measure(parameters);
+            if (!latency) {
+                return std::unexpected(latency.error());
+            }
+            if (*latency <= target.latency) {
+                break;
+            }
+            --parameters.t;
+        }
+        if (parameters.t == 1) {
+            latency = single;
+        }
+        return Argon2idCalibration{parameters, std::chrono::duration_cast<std::chrono::nanoseconds>(*latency), trials,
+                                   true};
+    }
+
+    std::expected<Argon2idBinding, Error> Hasher::hash(const std::string_view data, const Argon2id algorithm) {
+        ERR_clear_error();
+        EVP_KDF_CTX *const ctx = algorithms::kdf_context();
         if (!ctx) {
             return std::unexpected(Error(ERR_get_error()));
         }
@@ -64,31 +188,30 @@ namespace mehara::prapancha::security {
             return std::unexpected(Error(ERR_get_error()));
         }
         std::vector<uint8_t> hash(argon2id_hash_length);
-        const auto params = construct_algorithm_params(data, &argon2id_version, &argon2id_m, &argon2id_t, &argon2id_p,
-                                                       salt, algorithm);
-        if (EVP_KDF_derive(ctx.get(), hash.data(), hash.size(), params.data()) <= 0) {
+        const auto [m, t, p] = argon2id_parameters();
+        const ThreadReservation reservation(p);
+        const std::uint32_t threads = reservation.threads();
+        const auto params =
+                construct_algorithm_params(data, &argon2id_version, &m, &t, &p, &threads, salt, algorithm);
+        if (EVP_KDF_derive(ctx, hash.data(), hash.size(), params.data()) <= 0) {
             return std::unexpected(Error(ERR_get_error()));
         }
-        return Argon2idBinding{argon2id_version, argon2id_m, argon2id_t, argon2id_p, std::move(salt), std::move(hash)};
+        return Argon2idBinding{argon2id_version, m, t, p, std::move(salt), std::move(hash)};
     }
 
     std::expected<bool, Error> Hasher::verify(const std::string_view data, const Argon2idBinding &binding,
                                               const Argon2id algorithm) {
         ERR_clear_error();
-        const auto kdf = std::unique_ptr<EVP_KDF, decltype(&EVP_KDF_free)>(
-                EVP_KDF_fetch(nullptr, Argon2id::name.data(), nullptr), EVP_KDF_free);
-        if (!kdf) {
-            return std::unexpected(Error(ERR_get_error()));
-        }
-        const auto ctx =
-                std::unique_ptr<EVP_KDF_CTX, decltype(&EVP_KDF_CTX_free)>(EVP_KDF_CTX_new(kdf.get()), EVP_KDF_CTX_free);
+        EVP_KDF_CTX *const ctx = algorithms::kdf_context();
         if (!ctx) {
             return std::unexpected(Error(ERR_get_error()));
         }
         std::vector<uint8_t> check(binding.hash.size());
+        const ThreadReservation reservation(binding.p);
+        const std::uint32_t threads = reservation.threads();
         const auto params = construct_algorithm_params(data, &binding.version, &binding.m, &binding.t, &binding.p,
-                                                       binding.salt, algorithm);
-        if (EVP_KDF_derive(ctx.get(), check.data(), check.size(), params.data()) <= 0) {
+                                                       &threads, binding.salt, algorithm);
+        if (EVP_KDF_derive(ctx, check.data(), check.size(), params.data()) <= 0) {
             return std::unexpected(Error(ERR_get_error()));
         }
         const bool match = CRYPTO_memcmp(check.data(), binding.hash.data(), check.size()) == 0;
@@ -98,8 +221,13 @@ namespace mehara::prapancha::security {
 
     std::expected<Sha256Binding, Error> Hasher::hash(const std::string_view data, Sha256) {
         ERR_clear_error();
+        EVP_MD_CTX *const ctx = algorithms::digest_context();
+        if (!ctx || EVP_DigestInit_ex2(ctx, algorithms::sha256(), nullptr) <= 0 ||
+            EVP_DigestUpdate(ctx, data.data(), data.size()) <= 0) {
+            return std::unexpected(Error(ERR_get_error()));
+        }
         std::vector<uint8_t> hash(Sha256::digest_length);
-        if (!EVP_Q_digest(nullptr, Sha256::name.data(), nullptr, data.data(), data.size(), hash.data(), nullptr)) {
+        if (EVP_DigestFinal_ex(ctx, hash.data(), nullptr) <= 0) {
             return std::unexpected(Error(ERR_get_error()));
         }
         return Sha256Binding{std::move(hash)};
@@ -108,18 +236,18 @@ namespace mehara::prapancha::security {
     std::expected<Sha256Binding, Error> Hasher::hash(std::istream &stream, Sha256) {
         ERR_clear_error();
         constexpr std::size_t stream_buffer_size = 4096;
-        const auto ctx = std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>(EVP_MD_CTX_new(), EVP_MD_CTX_free);
-        if (!ctx || EVP_DigestInit_ex(ctx.get(), EVP_sha256(), nullptr) <= 0) {
+        EVP_MD_CTX *const ctx = algorithms::digest_context();
+        if (!ctx || EVP_DigestInit_ex2(ctx, algorithms::sha256(), nullptr) <= 0) {
             return std::unexpected(Error(ERR_get_error()));
         }
         char buffer[stream_buffer_size];
         while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0) {
-            if (EVP_DigestUpdate(ctx.get(), buffer, stream.gcount()) <= 0) {
+            if (EVP_DigestUpdate(ctx, buffer, stream.gcount()) <= 0) {
                 return std::unexpected(Error(ERR_get_error()));
             }
         }
         std::vector<uint8_t> hash(Sha256::digest_length);
-        if (EVP_DigestFinal_ex(ctx.get(), hash.data(), nullptr) <= 0) {
+        if (EVP_DigestFinal_ex(ctx, hash.data(), nullptr) <= 0) {
             return std::unexpected(Error(ERR_get_error()));
         }
         return Sha256Binding{std::move(hash)};
@@ -0,0 +1,142 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <prapancha/security/hashing_service.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include <openssl/crypto.h>
+
+namespace mehara::prapancha::security {
+
+    namespace {
+
+        void raise_peak(std::atomic<std::uint64_t> &peak, const std::uint64_t value) noexcept {
+            std::uint64_t current = peak.load(std::memory_order_relaxed);
+            while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+
+        /// Passwords are wiped from the worker's copy as soon as the derivation is done with them.
+        void cleanse(std::string &password) noexcept { OPENSSL_cleanse(password.data(), password.size()); }
+
+    } // namespace
+
+    HashingService::HashingService(const Options options) :
+        capacity_(std::max<std::size_t>(options.queue_capacity, 1)),
+        budget_(std::max(options.memory_budget, memory_of(Hasher::argon2id_parameters().m))), available_(budget_) {
+        const std::size_t workers =
+                options.workers != 0 ? options.workers : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        workers_.reserve(workers);
+        for (std::size_t i = 0; i < workers; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    HashingService::~HashingService() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        ready_.notify_all();
+        workers_.clear();
+    }
+
+    bool HashingService::enqueue(const std::uint64_t memory, std::move_only_function<void()> &&run) {
+        metrics_.submitted.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(mutex_);
+            if (queue_.size() >= capacity_ || stopping_) {
+                metrics_.rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            queue_.push_back(Job{memory, std::chrono::steady_clock::now(), std::move(run)});
+            metrics_.queue_depth.store(queue_.size(), std::memory_order_relaxed);
+            raise_peak(metrics_.peak_queue_depth, queue_.size());
+        }
+        ready_.notify_one();
+        return true;
+    }
+
+    void HashingService::work() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock lock(mutex_);
+                // Jobs start in submission order. One costing more than the whole budget runs alone rather than never.
+                ready_.wait(lock, [this] {
+                    return (stopping_ && queue_.empty()) ||
+                           (!queue_.empty() && std::min(queue_.front().memory, budget_) <= available_);
+                });
+                if (queue_.empty()) {
+                    return;
+                }
+                job = std::move(queue_.front());
+                queue_.pop_front();
+                job.memory = std::min(job.memory, budget_);
+                available_ -= job.memory;
+                metrics_.queue_depth.store(queue_.size(), std::memory_order_relaxed);
+            }
+            const auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                                     job.submitted);
+            metrics_.wait_nanoseconds.fetch_add(static_cast<std::uint64_t>(waited.count()), std::memory_order_relaxed);
+            raise_peak(metrics_.peak_wait_nanoseconds, static_cast<std::uint64_t>(waited.count()));
+            job.run();
+            metrics_.completed.fetch_add(1, std::memory_order_relaxed);
+            {
+                std::lock_guard lock(mutex_);
+                available_ += job.memory;
+            }
+            ready_.notify_all();
+        }
+    }
+
+    void HashingService::hash(std::string password, HashCompletion &&completion) {
+        auto shared = std::make_shared<HashCompletion>(std::move(completion));
+        const bool queued =
+                enqueue(memory_of(Hasher::argon2id_parameters().m), [password = std::move(password), shared]() mutable {
+                    auto result = Hasher::hash<Argon2id>(password);
+                    cleanse(password);
+                    (*shared)(std::move(result));
+                });
+        if (!queued) {
+            (*shared)(std::unexpected(Error(Error::Busy)));
+        }
+    }
+
+    void HashingService::verify(std::string password, Argon2idBinding binding, VerifyCompletion &&completion) {
+        auto shared = std::make_shared<VerifyCompletion>(std::move(completion));
+        const std::uint64_t memory = memory_of(binding.m);
+        const bool queued = enqueue(memory, [password = std::move(password), binding = std::move(binding),
+                                             shared]() mutable {
+            auto result = Hasher::verify<Argon2id>(password, binding);
+            cleanse(password);
+            (*shared)(std::move(result));
+        });
+        if (!queued) {
+            (*shared)(std::unexpected(Error(Error::Busy)));
+        }
+    }
+
+    std::future<std::expected<Argon2idBinding, Error>> HashingService::hash(std::string password) {
+        std::promise<std::expected<Argon2idBinding, Error>> promise;
+        auto future = promise.get_future();
+        hash(std::move(password), [promise = std::move(promise)](auto result) mutable {
+            promise.set_value(std::move(result));
+        });
+        return future;
+    }
+
+    std::future<std::expected<bool, Error>> HashingService::verify(std::string password, Argon2idBinding binding) {
+        std::promise<std::expected<bool, Error>> promise;
+        auto future = promise.get_future();
+        verify(std::move(password), std::move(binding), [promise = std::move(promise)](auto result) mutable {
+            promise.set_value(std::move(result));
+        });
+        return future;
+    }
+
+} // namespace mehara::prapancha::security
@@ -0,0 +1,137 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <prapancha/security/keyring.h>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <openssl/err.h>
+#include <openssl/evp.h>
+
+#include <prapancha/security/algorithms.h>
+
+namespace mehara::prapancha::security {
+
+    namespace {
+
+        /// Checks one signature on the calling thread's digest context.
+        std::expected<bool, Error> check(EVP_PKEY *key, const std::span<const uint8_t> data,
+                                         const std::span<const uint8_t> signature) {
+            EVP_MD_CTX *const ctx = algorithms::digest_context();
+            if (!ctx || EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, key) <= 0) {
+                return std::unexpected(Error(ERR_get_error()));
+            }
+            const int result = EVP_DigestVerify(ctx, signature.data(), signature.size(), data.data(), data.size());
+            if (result < 0) {
+                return std::unexpected(Error(ERR_get_error()));
+            }
+            return result == 1;
+        }
+
+    } // namespace
+
+    Ed25519Keyring::Ed25519Keyring() : keys_(std::make_shared<const Keys>()) {}
+
+    std::expected<void, Error> Ed25519Keyring::add(std::string id, const std::span<const uint8_t> public_key) {
+        auto key = Ed25519Key::from_public(public_key);
+        if (!key) {
+            return std::unexpected(key.error());
+        }
+        std::lock_guard lock(rotation_);
+        auto keys = std::make_shared<Keys>(*snapshot());
+        keys->insert_or_assign(std::move(id), std::move(*key));
+        keys_.store(std::move(keys), std::memory_order_release);
+        return {};
+    }
+
+    bool Ed25519Keyring::remove(const std::string_view id) {
+        std::lock_guard lock(rotation_);
+        const auto current = snapshot();
+        const auto found = current->find(id);
+        if (found == current->end()) {
+            return false;
+        }
+        auto keys = std::make_shared<Keys>(*current);
+        keys->erase(found->first);
+        keys_.store(std::move(keys), std::memory_order_release);
+        return true;
+    }
+
+    bool Ed25519Keyring::contains(const std::string_view id) const { return snapshot()->contains(id); }
+
+    std::size_t Ed25519Keyring::size() const { return snapshot()->size(); }
+
+    std::expected<bool, Error> Ed25519Keyring::verify(const std::string_view id, const std::span<const uint8_t> data,
+                                                      const std::span<const uint8_t> signature) const {
+        ERR_clear_error();
+        const auto keys = snapshot();
+        const auto found = keys->find(id);
+        if (found == keys->end()) {
+            return false;
+        }
+        return check(found->second.get(), data, signature);
+    }
+
+    std::expected<void, Error> Ed25519Keyring::verify(const Keys &keys, const std::span<const Ed25519Check> checks,
+                                                      const std::span<bool> results) {
+        ERR_clear_error();
+        for (std::size_t i = 0; i < checks.size(); ++i) {
+            const auto &[id, data, signature] = checks[i];
+            const auto found = keys.find(id);
+            if (found == keys.end()) {
+                results[i] = false;
+                continue;
+            }
+            const auto result = check(found->second.get(), data, signature);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+            results[i] = *result;
+        }
+        return {};
+    }
+
+    std::size_t Ed25519Keyring::threads_for(const std::size_t checks, const std::size_t parallel_threshold) noexcept {
+        if (checks < parallel_threshold) {
+            return 1;
+        }
+        const std::size_t cores = std::max(1U, std::thread::hardware_concurrency());
+        return std::max<std::size_t>(1, std::min(cores, checks));
+    }
+
+    std::expected<void, Error> Ed25519Keyring::verify_many(const std::span<const Ed25519Check> checks,
+                                                           const std::span<bool> results,
+                                                           const std::size_t parallel_threshold) const {
+        if (results.size() < checks.size()) {
+            ERR_clear_error();
+            ERR_raise(ERR_LIB_EVP, EVP_R_BUFFER_TOO_SMALL);
+            return std::unexpected(Error(ERR_get_error()));
+        }
+        const auto keys = snapshot();
+        const std::size_t threads = threads_for(checks.size(), parallel_threshold);
+        if (threads <= 1) {
+            return verify(*keys, checks, results);
+        }
+        // The calling thread takes the first share; each helper reports its own failure, and the first one wins.
+        const std::size_t share = (checks.size() + threads - 1) / threads;
+        std::vector<std::expected<void, Error>> outcomes(threads);
+        {
+            std::vector<std::jthread> helpers;
+            helpers.reserve(threads - 1);
+            for (std::size_t t = 1; t < threads; ++t) {
+                const std::size_t begin = std::min(t * share, checks.size());
+                const std::size_t count = std::min(share, checks.size() - begin);
+                helpers.emplace_back([&keys, &outcomes, t, part = checks.subspan(begin, count),
+                                      out = results.subspan(begin, count)] { outcomes[t] = verify(*keys, part, out); });
+            }
+            outcomes[0] = verify(*keys, checks.first(std::min(share, checks.size())), results);
+        }
+        const auto failed = std::ranges::find_if(outcomes, [](const auto &outcome) { return !outcome; });
+        return failed == outcomes.end() ? std::expected<void, Error>{} : *failed;
+    }
+
+} // namespace mehara::prapancha::security
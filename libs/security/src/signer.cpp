@@ -11,48 +11,69 @@
 #include <openssl/err.h>
 #include <openssl/evp.h>
 
+#include <prapancha/security/algorithms.h>
 #include <prapancha/security/error.h>
 
 namespace mehara::prapancha::security {
 
-    std::expected<Ed25519Binding, Error> Signer::sign(const std::vector<uint8_t> &data,
-                                                      const std::vector<uint8_t> &private_key, Ed25519) {
+    std::expected<Ed25519Key, Error> Ed25519Key::from_private(const std::span<const uint8_t> raw) {
         ERR_clear_error();
-        const auto pkey = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>(
-                EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, nullptr, private_key.data(), private_key.size()),
-                EVP_PKEY_free);
-        if (!pkey) {
+        EVP_PKEY *key = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, nullptr, raw.data(), raw.size());
+        if (!key) {
             return std::unexpected(Error(ERR_get_error()));
         }
-        const auto ctx = std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>(EVP_MD_CTX_new(), EVP_MD_CTX_free);
-        if (!ctx || EVP_DigestSignInit(ctx.get(), nullptr, nullptr, nullptr, pkey.get()) <= 0) {
+        return Ed25519Key(std::shared_ptr<EVP_PKEY>(key, EVP_PKEY_free));
+    }
+
+    std::expected<Ed25519Key, Error> Ed25519Key::from_public(const std::span<const uint8_t> raw) {
+        ERR_clear_error();
+        EVP_PKEY *key = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr, raw.data(), raw.size());
+        if (!key) {
+            return std::unexpected(Error(ERR_get_error()));
+        }
+        return Ed25519Key(std::shared_ptr<EVP_PKEY>(key, EVP_PKEY_free));
+    }
+
+    std::expected<Ed25519Binding, Error> Signer::sign(const std::vector<uint8_t> &data,
+                                                      const std::vector<uint8_t> &private_key, Ed25519) {
+        return Ed25519Key::from_private(private_key).and_then([&](const Ed25519Key &key) {
+            return sign(data, key, Ed25519{});
+        });
+    }
+
+    std::expected<bool, Error> Signer::verify(const std::vector<uint8_t> &data, const Ed25519Binding &binding,
+                                              const std::vector<uint8_t> &public_key, Ed25519) {
+        return Ed25519Key::from_public(public_key).and_then([&](const Ed25519Key &key) {
+            return verify(data, binding, key, Ed25519{});
+        });
+    }
+
+    std::expected<Ed25519Binding, Error> Signer::sign(const std::vector<uint8_t> &data, const Ed25519Key &private_key,
+                                                      Ed25519) {
+        ERR_clear_error();
+        EVP_MD_CTX *const ctx = algorithms::digest_context();
+        if (!ctx || EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr, private_key.get()) <= 0) {
             return std::unexpected(Error(ERR_get_error()));
         }
         std::size_t signature_length = 0;
-        if (EVP_DigestSign(ctx.get(), nullptr, &signature_length, data.data(), data.size()) <= 0) {
+        if (EVP_DigestSign(ctx, nullptr, &signature_length, data.data(), data.size()) <= 0) {
             return std::unexpected(Error(ERR_get_error()));
         }
         std::vector<uint8_t> signature(signature_length);
-        if (EVP_DigestSign(ctx.get(), signature.data(), &signature_length, data.data(), data.size()) <= 0) {
+        if (EVP_DigestSign(ctx, signature.data(), &signature_length, data.data(), data.size()) <= 0) {
             return std::unexpected(Error(ERR_get_error()));
         }
         return Ed25519Binding{std::move(signature)};
     }
 
     std::expected<bool, Error> Signer::verify(const std::vector<uint8_t> &data, const Ed25519Binding &binding,
-                                              const std::vector<uint8_t> &public_key, Ed25519) {
+                                              const Ed25519Key &public_key, Ed25519) {
         ERR_clear_error();
-        const auto pkey = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>(
-                EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr, public_key.data(), public_key.size()),
-                EVP_PKEY_free);
-        if (!pkey) {
-            return std::unexpected(Error(ERR_get_error()));
-        }
-        const auto ctx = std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>(EVP_MD_CTX_new(), EVP_MD_CTX_free);
-        if (!ctx || EVP_DigestVerifyInit(ctx.get(), nullptr, nullptr, nullptr, pkey.get()) <= 0) {
+        EVP_MD_CTX *const ctx = algorithms::digest_context();
+        if (!ctx || EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, public_key.get()) <= 0) {
             return std::unexpected(Error(ERR_get_error()));
         }
-        const int result = EVP_DigestVerify(ctx.get(), binding.signature.data(), binding.signature.size(), data.data(),
+        const int result = EVP_DigestVerify(ctx, binding.signature.data(), binding.signature.size(), data.data(),
                                             data.size());
         if (result < 0) {
             return std::unexpected(Error(ERR_get_error()));
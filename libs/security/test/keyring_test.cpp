@@ -0,0 +1,84 @@
+//
+// Created by Aman Mehara on 17/10/26.
+//
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <openssl/evp.h>
+
+#include <prapancha/security/keyring.h>
+#include <prapancha/security/signer.h>
+
+namespace {
+
+    using namespace mehara::prapancha::security;
+
+    constexpr std::size_t threshold = 256;
+
+    bool report(const bool passed, const char *what, const std::size_t checks) {
+        std::printf("%s %s (%zu checks)\n", passed ? "PASS" : "FAIL", what, checks);
+        return passed;
+    }
+
+    /// Splits at exactly the threshold, as documented, and not only from twice the threshold.
+    bool split(const std::size_t checks) {
+        const std::size_t cores = std::max(1U, std::thread::hardware_concurrency());
+        const std::size_t expected = checks < threshold ? 1 : std::min(cores, checks);
+        return report(Ed25519Keyring::threads_for(checks, threshold) == expected, "threads_for", checks);
+    }
+
+    /// Every other signature is corrupted; each result must still land in its own slot.
+    bool verify(const Ed25519Keyring &keyring, const std::vector<uint8_t> &data, const Ed25519Binding &signature,
+                const Ed25519Binding &forged, const std::size_t checks) {
+        std::vector<Ed25519Check> batch;
+        for (std::size_t i = 0; i < checks; ++i) {
+            batch.push_back({i % 3 == 2 ? "retired" : "current", data,
+                             i % 2 == 0 ? signature.signature : forged.signature});
+        }
+        const auto results = std::make_unique<bool[]>(checks);
+        const auto outcome = keyring.verify_many(batch, std::span(results.get(), checks), threshold);
+        bool passed = outcome.has_value();
+        for (std::size_t i = 0; passed && i < checks; ++i) {
+            passed = results[i] == (i % 2 == 0 && i % 3 != 2);
+        }
+        return report(passed, "verify_many", checks);
+    }
+
+} // namespace
+
+int main() {
+    EVP_PKEY *generated = EVP_PKEY_Q_keygen(nullptr, nullptr, "ED25519");
+    std::vector<uint8_t> private_key(32);
+    std::vector<uint8_t> public_key(32);
+    std::size_t length = private_key.size();
+    const bool exported = generated && EVP_PKEY_get_raw_private_key(generated, private_key.data(), &length) == 1 &&
+                          (length = public_key.size(), EVP_PKEY_get_raw_public_key(generated, public_key.data(),
+                                                                                    &length) == 1);
+    EVP_PKEY_free(generated);
+    const std::vector<uint8_t> data{'p', 'r', 'a', 'p', 'a', 'n', 'c', 'h', 'a'};
+    const auto key = exported ? Ed25519Key::from_private(private_key) : std::unexpected(Error(0));
+    const auto signature = key ? Signer::sign<Ed25519>(data, *key) : std::unexpected(Error(0));
+    Ed25519Keyring keyring;
+    if (!signature || !keyring.add("current", public_key)) {
+        std::printf("FAIL key setup\n");
+        return EXIT_FAILURE;
+    }
+    Ed25519Binding forged = *signature;
+    forged.signature[0] ^= 0x01;
+    bool passed = true;
+    for (const std::size_t checks: {threshold - 1, threshold, threshold + 1, 2 * threshold - 1}) {
+        passed &= split(checks);
+        passed &= verify(keyring, data, *signature, forged, checks);
+    }
+    passed &= report(Ed25519Keyring::threads_for(3, 0) == std::min<std::size_t>(
+                                                                 3, std::max(1U, std::thread::hardware_concurrency())),
+                     "threads_for never exceeds the batch", 3);
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}